@@ -1,16 +1,149 @@
 #include "Indicators.hh"
 
-double Indicators::angle(const ACG::Vec3d& d0, const ACG::Vec3d& d1) const
+unsigned int Indicators::num_threads() const
 {
-    auto d0_norm = d0.norm();
-    auto d1_norm = d1.norm();
-    auto denorm = d0_norm*d1_norm;
+    if (num_threads_ > 0)
+        return num_threads_;
 
-    if(denorm > std::numeric_limits<double>::min())
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void Indicators::invalidate_indicators()
+{
+    for (State& state: states_)
+    {
+        state.valid = false;
+        state.log_position = 0;
+        state.chunks.clear();
+    }
+
+    modified_faces_.clear();
+}
+
+void Indicators::store_states(const std::vector<indicatorsType::indicators>& _indicators,
+    const std::vector<Reduction>& _partials, const std::vector<IndicatorsDistribution>& _distributions,
+    const std::vector<IndicatorsWorst>& _worst)
+{
+    const size_t n_values = _indicators.size();
+    const size_t chunks = n_values ? _partials.size() / n_values : 0;
+
+    for (size_t k(0); k < n_values; ++k)
+    {
+        State& state = states_[_indicators[k]];
+        state.valid = true;
+        state.log_position = modified_faces_.size();
+        state.chunks.resize(chunks);
+        for (size_t c(0); c < chunks; ++c)
+        {
+            state.chunks[c] = _partials[c * n_values + k];
+        }
+        state.distribution = _distributions[k];
+        state.worst = _worst[k];
+    }
+}
+
+void Indicators::set_single_precision(const bool _single)
+{
+    single_precision_ = _single;
+
+    // a rebuilt snapshot recomputes the indicators, the properties follow in sync_properties()
+    snapshot_.set_single_precision(_single);
+}
+
+void Indicators::set_histogram(const size_t _bins, const double _lo, const double _hi)
+{
+    if (_bins == histogram_bins_ && _lo == histogram_lo_ && _hi == histogram_hi_)
+        return;
+
+    histogram_bins_ = _bins;
+    histogram_lo_ = _lo;
+    histogram_hi_ = _hi;
+
+    // the stored distributions have the previous bins
+    invalidate_indicators();
+}
+
+Indicators::Result Indicators::merge(const std::vector<Result>& _results)
+{
+    Reduction merged;
+    for (const Result& r: _results)
+    {
+        if (r.min < 0 || r.nb == 0)
+            continue;
+
+        Reduction partial;
+        partial.min = r.min;
+        partial.max = r.max;
+        partial.sum = r.average * r.nb;
+        partial.nb = r.nb;
+        partial.distribution = r.distribution;
+        merged.merge(partial);
+    }
+
+    if (merged.nb == 0)
+    {
+        Result r;
+        r.min = -1;
+        r.max = 0;
+        r.average = 0;
+        return r;
+    }
+
+    return merged.result();
+}
+
+//====================================================================================================================//
+Indicators::Request Indicators::request(const std::vector<indicatorsType::indicators>& _indicators, const bool* _defined)
+{
+    Request r;
+    std::fill(r.slots, r.slots + indicatorsType::n_indicators, -1);
+
+    for (auto i: _indicators)
+    {
+        if (_defined[i] && r.slots[i] < 0)
+        {
+            r.slots[i] = static_cast<int>(r.active.size());
+            r.active.push_back(i);
+        }
+    }
+
+    return r;
+}
+
+std::vector<Indicators::Result> Indicators::results(const std::vector<indicatorsType::indicators>& _indicators,
+    const Request& _request, const std::vector<Reduction>& _reductions)
+{
+    std::vector<Result> results(_indicators.size());
+    for (size_t k(0); k < _indicators.size(); ++k)
+    {
+        const int slot = _request.slots[_indicators[k]];
+        if (slot >= 0)
+        {
+            results[k] = _reductions[slot].result();
+        }
+          else
+        {
+            // not defined on the elements of the mesh
+            results[k].min = -1;
+            results[k].max = 0;
+            results[k].average = 0;
+        }
+    }
+
+    return results;
+}
+
+Indicators::ColorMap Indicators::color_map(const double _min_value, const double _max_value)
+{
+    if (color_table_.empty())
     {
-        double cos = std::min(1.0, std::max(-1.0, (d0 | d1) / denorm));
-        return std::acos(cos);
+        color_.set_range(0, 1.0, false);
+        color_table_.resize(color_table_size);
+        for (size_t i(0); i < color_table_size; ++i)
+        {
+            color_table_[i] = color_.color_float4(float(i) / (color_table_size - 1));
+        }
     }
 
-    return 0;
-}
\ No newline at end of file
+    return ColorMap(color_table_, _min_value, _max_value);
+}
@@ -5,6 +5,21 @@
 
 #include <ObjectTypes/PolyMesh/PolyMesh.hh>
 
+#include "IndicatorsType.hh"
+#include "IndicatorsRegistry.hh"
+#include "IndicatorsSnapshot.hh"
+#include "IndicatorsDistribution.hh"
+#include "IndicatorsWorst.hh"
+#include "IndicatorsColumns.hh"
+#include "IndicatorsProfile.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 class Indicators
 {
 public:
@@ -15,43 +30,1180 @@ public:
         double min;
         double max;
         double average;
+
+        // number of faces the values were taken over
+        size_t nb = 0;
+
+        // histogram and quantiles of the values, e.g. distribution.quantile(0.01) or distribution.count_below(0.2)
+        IndicatorsDistribution distribution;
+
+        // the worst faces, or cells, as set by set_worst_faces(), e.g. worst.faces().front().face
+        IndicatorsWorst worst;
     };
 
-    Indicators() {}
+    // combined result of several meshes, the average weighted by their number of faces and the distributions
+    // summed, undefined results are skipped. the worst faces are per mesh and not merged
+    static Result merge(const std::vector<Result>&);
+
+    Indicators():
+    cancelled_(false), progress_done_(0), progress_total_(0), coloring_(true),
+    geometry_changed_(false), incremental_(true), histogram_bins_(100), histogram_lo_(0.0), histogram_hi_(1.0),
+    worst_k_(0), worst_threshold_(std::numeric_limits<double>::quiet_NaN()),
+    single_precision_(false), num_threads_(0) {}
 
     virtual ~Indicators() {}
 
 public:
-    virtual Result warping() = 0;
+    Result compute(const indicatorsType::indicators& _i) { return compute_all({_i}).front(); }
+
+    // one Result per requested indicator, evaluated in a single fused traversal. faces are colored by the first
+    // defined one, the indicators not defined on the elements of the mesh have min -1
+    virtual std::vector<Result> compute_all(const std::vector<indicatorsType::indicators>&) = 0;
+
+    // 0 uses every hardware thread, 1 runs the face loops on the calling thread
+    void set_num_threads(const unsigned int _num_threads) { num_threads_ = _num_threads; }
+
+    unsigned int num_threads() const;
+
+    // drops the geometry snapshot, to be called when the mesh has been modified
+    void invalidate_snapshot() { snapshot_.clear(); }
+
+    // the vertex positions changed, the moved vertices are found by comparing against the snapshot
+    virtual void geometry_changed() { geometry_changed_ = true; }
+
+    // the given vertices moved, cheaper than geometry_changed() when the caller knows them
+    virtual void vertices_changed(const std::vector<unsigned int>& _vertices)
+    {
+        moved_vertices_.insert(moved_vertices_.end(), _vertices.begin(), _vertices.end());
+    }
+
+    // only the faces modified since the previous evaluation of an indicator are recomputed, otherwise an edit
+    // makes the next evaluation a full pass
+    void set_incremental(const bool _incremental) { incremental_ = _incremental; }
+
+    bool incremental() const { return incremental_; }
+
+    // the face values are stored in float properties and the snapshot keeps float coordinates, about half the
+    // memory traffic of the passes. the values are still evaluated in double from the rounded coordinates, and
+    // reduced in double from the rounded values. changing it recomputes every indicator
+    void set_single_precision(const bool _single);
+
+    bool single_precision() const { return single_precision_; }
+
+    // bins of the histograms of the results, values outside of [_lo, _hi] are only counted
+    void set_histogram(const size_t _bins, const double _lo, const double _hi);
+
+    // empty distribution with the histogram bins
+    IndicatorsDistribution distribution() const
+    {
+        return IndicatorsDistribution(histogram_bins_, histogram_lo_, histogram_hi_);
+    }
+
+    // the evaluations also collect the _k worst faces of every indicator into Result::worst, among the ones worse
+    // than _threshold unless it is NaN, i.e. below it or above it for warping. they are kept during the passes
+    // with bounded heaps, an up to date indicator only scans its stored values again when the query changed.
+    // 0 disables it
+    void set_worst_faces(const size_t _k, const double _threshold = std::numeric_limits<double>::quiet_NaN())
+    {
+        worst_k_ = _k;
+        worst_threshold_ = _threshold;
+    }
+
+    // empty selection of the worst faces of _i
+    IndicatorsWorst worst(const indicatorsType::indicators& _i) const
+    {
+        return IndicatorsWorst(worst_k_, worst_threshold_, indicatorsRegistry::entry(_i).higher_is_worse);
+    }
+
+    // when disabled the evaluation only writes the values, apply_colors() colors the mesh afterwards, e.g. on
+    // another thread than the one that computed them
+    void set_coloring(const bool _coloring) { coloring_ = _coloring; }
+
+    bool coloring() const { return coloring_; }
+
+    // value of _i on face _f as stored by its last evaluation
+    virtual double value(const indicatorsType::indicators& _i, const size_t _f) const = 0;
+
+    // colors the mesh by the values of _i, _result being the one its evaluation returned
+    virtual void apply_colors(const indicatorsType::indicators& _i, const Result& _result)
+    {
+        color_coding(_i, _result.min, _result.max);
+    }
+
+    // selects the faces of _result.worst, or the cells on a tetrahedral mesh, and deselects the other ones
+    virtual void select_worst(const Result& _result) = 0;
+
+    // writes the face values of the indicators evaluated and not edited since to an IndicatorsColumns file, with
+    // the content hash of the mesh, in the precision of the properties. false when it cannot be written or the
+    // mesh has no face values
+    virtual bool export_values(const std::string&) { return false; }
+
+    // copies the values of an IndicatorsColumns file of the same mesh into the face properties, its indicators
+    // are then up to date and their next evaluation only returns the results. false when the file is not one
+    // of this mesh, e.g. after an edit
+    virtual bool load_values(const std::string&) { return false; }
+
+    // may be called from any thread, the loops stop at the next chunk. the results of a cancelled evaluation
+    // are meaningless and the indicators it touched are recomputed from scratch next time.
+    // cancel(false) clears the request before the next evaluation
+    void cancel(const bool _cancel = true) { cancelled_ = _cancel; }
+
+    bool cancelled() const { return cancelled_; }
+
+    // fraction of the chunks of the running loop that are done, an evaluation runs one or more loops
+    double progress() const
+    {
+        const size_t total = progress_total_;
+        return total ? std::min(1.0, double(progress_done_) / total) : 0.0;
+    }
+
+    // wall time of the phases and counters of the last evaluation, e.g. profile().report().text(). the phases
+    // timed after it, as apply_colors() and select_worst(), add to it
+    const IndicatorsProfile& profile() const { return profile_; }
+
+    IndicatorsProfile& profile() { return profile_; }
+
+protected:
+    // faces per work item of the parallel loops
+    static constexpr size_t chunk_size = 4096;
+
+    // triangles gathered per batched kernel call, a multiple of indicatorsSimd::padding
+    static constexpr size_t block_size = 256;
+
+    // min/max/sum of the values of one chunk of faces, and their distribution while the chunk is reduced
+    struct Reduction
+    {
+        double min = std::numeric_limits<double>::max();
+        double max = 0;
+        double sum = 0;
+        size_t nb = 0;
+
+        IndicatorsDistribution distribution;
+        IndicatorsWorst worst;
+
+        void add(const size_t _f, const double _value)
+        {
+            accumulate(_value);
+            distribution.add(_value);
+            worst.add(static_cast<unsigned int>(_f), _value);
+        }
+
+        // min/max/sum only
+        void accumulate(const double _value)
+        {
+            sum += _value;
+            nb++;
+
+            if (_value > max)
+                max = _value;
+            if (_value < min)
+                min = _value;
+        }
+
+        void merge(const Reduction& _r)
+        {
+            sum += _r.sum;
+            nb += _r.nb;
+            max = std::max(max, _r.max);
+            min = std::min(min, _r.min);
+            distribution.merge(_r.distribution);
+            worst.merge(_r.worst);
+        }
+
+        Result result() const
+        {
+            Result r;
+            r.min = min;
+            r.max = max;
+            r.average = sum / nb;
+            r.nb = nb;
+            r.distribution = distribution;
+            r.worst = worst;
+            return r;
+        }
+    };
+
+    static size_t n_chunks(const size_t _n) { return (_n + chunk_size - 1) / chunk_size; }
+
+    // calls _kernel(chunk, begin, end) for every chunk of [0, _n) on num_threads() workers
+    template<class Kernel>
+    void for_each_chunk(const size_t _n, Kernel&& _kernel) const;
+
+    // calls _kernel(chunk, begin, end, reductions) for every chunk of [0, _n), reductions being the _n_values
+    // partials of the chunk. their distributions are summed into _distributions as soon as the chunk is done, so
+    // only the running chunks hold one, the partials keep min/max/sum. the same for their worst faces, merged into
+    // _worst which holds the empty selections of the values on entry
+    template<class Kernel>
+    void reduce_chunks(const size_t _n, const size_t _n_values, std::vector<Reduction>& _partials,
+        std::vector<IndicatorsDistribution>& _distributions, std::vector<IndicatorsWorst>& _worst,
+        Kernel&& _kernel) const;
+
+    // faces handed to an evaluation kernel, all faces of a chunk or a sorted list of faces of one chunk
+    struct Faces
+    {
+        size_t chunk;
+        size_t begin;
+        const unsigned int* indices;
+        size_t n;
+
+        size_t operator[](const size_t _i) const { return indices ? indices[_i] : begin + _i; }
+    };
+
+    // calls _kernel(item) for every item of [0, _n) on num_threads() workers
+    template<class Kernel>
+    void for_each(const size_t _n, Kernel&& _kernel) const;
+
+    // _kernel(faces, reductions) writes the face properties of _indicators and adds the values to one reduction
+    // per indicator, reductions is null when the chunk is reduced again from the properties afterwards.
+    // the chunk reductions are kept per indicator, so the next evaluation only reruns the kernel on the faces
+    // modified in between and rescans their chunks. they are merged in chunk order, the result depends neither on
+    // the number of threads nor on whether the evaluation was incremental
+    template<class MeshT, class Kernel>
+    std::vector<Reduction> evaluate(MeshT& _mesh, const std::vector<indicatorsType::indicators>& _indicators,
+        Kernel&& _kernel);
+
+    // rebuilds the snapshot after a topology change, otherwise updates the moved vertices and logs their faces
+    template<class MeshT>
+    void sync_snapshot(const MeshT& _mesh, const unsigned int _arity = 0);
+
+    // every indicator is computed again from scratch on its next evaluation
+    void invalidate_indicators();
+
+    // collects _worst again from the stored values of [0, _n), without evaluating them
+    template<class Values>
+    void collect_worst(const size_t _n, const Values& _values, IndicatorsWorst& _worst) const;
+
+    // status selection of the faces of _worst, the other faces of _mesh are deselected
+    template<class MeshT>
+    void select_faces(MeshT& _mesh, const IndicatorsWorst& _worst) const;
+
+    // IndicatorsColumns::Hash of the points of _mesh and of the faces of the snapshot
+    template<class MeshT>
+    uint64_t content_hash(const MeshT& _mesh) const;
+
+    // export_values() and load_values() with the snapshot up to date
+    template<class MeshT>
+    bool export_columns(MeshT& _mesh, const std::string& _path);
+
+    template<class MeshT>
+    bool load_columns(MeshT& _mesh, const std::string& _path);
+
+    // values of one indicator, in its double face property or, in single precision, in its float one
+    template<class MeshT>
+    class FaceValues
+    {
+    public:
+        FaceValues(MeshT& _mesh, const OpenMesh::FPropHandleT<double>& _double, const OpenMesh::FPropHandleT<float>& _float):
+        mesh_(_mesh), double_(_double), float_(_float)
+        {
+        }
 
-    virtual Result aspect_ratio() = 0;
+        double operator[](const size_t _f) const
+        {
+            const auto fh = mesh_.face_handle(_f);
+            return float_.is_valid() ? mesh_.property(float_, fh) : mesh_.property(double_, fh);
+        }
 
-    virtual Result skewness() = 0;
+        // returns the value as stored, the reductions take it so that a rescan of the property agrees with them
+        double set(const size_t _f, const double _value)
+        {
+            const auto fh = mesh_.face_handle(_f);
+            if (float_.is_valid())
+                return mesh_.property(float_, fh) = static_cast<float>(_value);
 
-    virtual Result taper() = 0;
+            return mesh_.property(double_, fh) = _value;
+        }
 
-    virtual Result interpolation_quality() = 0;
+    private:
+        MeshT& mesh_;
+        OpenMesh::FPropHandleT<double> double_;
+        OpenMesh::FPropHandleT<float> float_;
+    };
+
+    template<class MeshT>
+    FaceValues<MeshT> face_values(MeshT& _mesh, const indicatorsType::indicators& _i) const
+    {
+        return FaceValues<MeshT>(_mesh, face_double_[_i], face_float_[_i]);
+    }
+
+    // adds the double face properties of the indicators evaluated on Element, named after them
+    template<class Element, class MeshT>
+    void add_properties(MeshT& _mesh);
+
+    // replaces the face properties by the ones of the other precision when it changed, their values are lost
+    template<class MeshT>
+    void sync_properties(MeshT& _mesh);
+
+    // removes the face properties of both precisions
+    template<class MeshT>
+    void remove_properties(MeshT& _mesh);
+
+    // the indicators of a request that a fused loop evaluates, each once
+    struct Request
+    {
+        std::vector<indicatorsType::indicators> active;
+
+        // position in active of every indicator, -1 when it is not evaluated
+        int slots[indicatorsType::n_indicators];
+    };
+
+    // _defined[id] when the loop evaluates indicator id
+    static Request request(const std::vector<indicatorsType::indicators>&, const bool* _defined);
+
+    // result of every requested indicator from the reductions of the active ones, undefined for the others
+    static std::vector<Result> results(const std::vector<indicatorsType::indicators>&, const Request&,
+        const std::vector<Reduction>&);
+
+    // evaluation of the active indicators of _list on the faces [_begin, _end) of a face source, shared by the
+    // meshes in memory and the streamed files. _store(i, k, value) takes value k of face i, false when the source
+    // could not give a face, the faces after it are not evaluated. the source gives
+    //   triangle(i, tr)        the corners of face i, false when they are invalid
+    //   cached()               edges(i, sqr_e, e) gives the squared lengths and lengths of its 3 edges
+    // the faces are gathered in blocks for the batched _kernel, the other indicators are called per face
+    template<class Source, class Store, class... Is>
+    bool evaluate_triangles(indicatorsRegistry::List<Is...>, const Source& _source, const size_t _begin,
+        const size_t _end, const indicatorsSimd::Kernel _kernel, const Request& _request, Store&& _store) const;
+
+    // the same on polygons, the source gives
+    //   polygon(i, points)     the corners of face i, false when they are invalid
+    //   face(i)                the index of face i, the point shuffling of face i is seeded from it and _seed
+    // the faces are visited in the order _begin + _order[j] of _end - _begin positions, in order when it is null
+    template<class Source, class Store, class... Is>
+    bool evaluate_polygons(indicatorsRegistry::List<Is...>, const Source& _source, const size_t _begin,
+        const size_t _end, const unsigned int* _order, const unsigned int _seed, indicatorsRegistry::Workspace&,
+        const Request& _request, Store&& _store) const;
+
+protected:
+    // color_coding() unless the coloring is disabled
+    void color(const indicatorsType::indicators& _i, const double _min_value, const double _max_value)
+    {
+        if (coloring_)
+            color_coding(_i, _min_value, _max_value);
+    }
 
-    virtual Result mean_ratio() = 0;
+    // colors of color_ over [min, max] from a table sampled once, a value is mapped by one multiply and one
+    // lookup instead of an interpolation of the color coder. a degenerate range, e.g. on a uniform mesh, maps
+    // every value to the lowest color
+    class ColorMap
+    {
+    public:
+        ColorMap(const std::vector<ACG::Vec4f>& _table, const double _min_value, const double _max_value):
+        table_(_table), min_(_min_value),
+        scale_(_max_value - _min_value > std::numeric_limits<double>::min() ? (_table.size() - 1) / (_max_value - _min_value) : 0.0)
+        {
+        }
+
+        const ACG::Vec4f& operator()(const double _value) const
+        {
+            // NaN and the values under the range take the first entry
+            const double t = (_value - min_) * scale_ + 0.5;
+            return table_[t > 0 ? std::min(table_.size() - 1, static_cast<size_t>(t)) : 0];
+        }
+
+    private:
+        const std::vector<ACG::Vec4f>& table_;
+        double min_;
+        double scale_;
+    };
+
+    ColorMap color_map(const double _min_value, const double _max_value);
 
-    virtual Result shape_regularity() = 0;
+    // colors the mesh by the values of _i over [min, max]
+    virtual void color_coding(const indicatorsType::indicators&, const double, const double) = 0;
 
 protected:
-    double angle(const ACG::Vec3d&, const ACG::Vec3d&) const;
+    // properties of the indicators defined on the faces, invalid for the others and in single precision
+    OpenMesh::FPropHandleT<double> face_double_[indicatorsType::n_indicators];
 
-    virtual void color_coding(const OpenMesh::FPropHandleT<double>&, const double, const double) = 0;
+    // float properties replacing the ones above in single precision
+    OpenMesh::FPropHandleT<float> face_float_[indicatorsType::n_indicators];
 
 protected:
-    OpenMesh::FPropHandleT<double> face_warping_;
-    OpenMesh::FPropHandleT<double> face_aspect_ratio_;
-    OpenMesh::FPropHandleT<double> face_skewness_;
-    OpenMesh::FPropHandleT<double> face_taper_;
-    OpenMesh::FPropHandleT<double> face_interpolation_quality_;
-    OpenMesh::FPropHandleT<double> face_mean_ratio_;
-    OpenMesh::FPropHandleT<double> face_shape_regularity_;
+    IndicatorsSnapshot snapshot_;
+
+    // the loops add their counters and allocations from const members
+    mutable IndicatorsProfile profile_;
+
+private:
+    std::atomic<bool> cancelled_;
+
+    mutable std::atomic<size_t> progress_done_;
+    mutable std::atomic<size_t> progress_total_;
+
+    bool coloring_;
+
+    // chunk reductions and distribution of the last evaluation of one indicator, and the part of
+    // modified_faces_ it has seen
+    struct State
+    {
+        bool valid = false;
+        size_t log_position = 0;
+        std::vector<Reduction> chunks;
+        IndicatorsDistribution distribution;
+        IndicatorsWorst worst;
+    };
+
+    State states_[indicatorsType::n_indicators];
+
+    // keeps the chunk reductions, distributions and worst faces of _indicators as their up to date state
+    void store_states(const std::vector<indicatorsType::indicators>& _indicators, const std::vector<Reduction>& _partials,
+        const std::vector<IndicatorsDistribution>& _distributions, const std::vector<IndicatorsWorst>& _worst);
+
+    // faces modified since the oldest evaluation, may hold duplicates
+    std::vector<unsigned int> modified_faces_;
+
+    std::vector<unsigned int> moved_vertices_;
+    bool geometry_changed_;
+
+    bool incremental_;
+
+    size_t histogram_bins_;
+    double histogram_lo_;
+    double histogram_hi_;
+
+    size_t worst_k_;
+    double worst_threshold_;
+
+    bool single_precision_;
 
 protected:
     ACG::ColorCoder color_;
+
+    // entries of the color table of color_map()
+    static constexpr size_t color_table_size = 1024;
+    std::vector<ACG::Vec4f> color_table_;
+
+private:
+    unsigned int num_threads_;
 };
 
+//====================================================================================================================//
+template<class Kernel>
+void Indicators::for_each(const size_t _n, Kernel&& _kernel) const
+{
+    const size_t threads = std::min<size_t>(num_threads(), _n);
+
+    progress_done_ = 0;
+    progress_total_ = _n;
+
+    std::atomic<size_t> next(0);
+    auto worker = [&](const bool _spawned)
+    {
+        const size_t allocations = IndicatorsProfile::thread_allocations();
+
+        for (size_t i = next++; i < _n && !cancelled_; i = next++)
+        {
+            _kernel(i);
+            progress_done_++;
+        }
+
+        // the calling thread is counted by the profile of the evaluation
+        if (_spawned)
+            profile_.add(IndicatorsProfile::ALLOCATIONS, IndicatorsProfile::thread_allocations() - allocations);
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t t(1); t < threads; ++t)
+    {
+        workers.emplace_back(worker, true);
+    }
+
+    worker(false);
+
+    for (auto& w: workers)
+    {
+        w.join();
+    }
+}
+
+template<class Kernel>
+void Indicators::for_each_chunk(const size_t _n, Kernel&& _kernel) const
+{
+    for_each(n_chunks(_n), [&](const size_t _c)
+    {
+        _kernel(_c, _c * chunk_size, std::min(_n, (_c + 1) * chunk_size));
+    });
+}
+
+template<class Kernel>
+void Indicators::reduce_chunks(const size_t _n, const size_t _n_values, std::vector<Reduction>& _partials,
+    std::vector<IndicatorsDistribution>& _distributions, std::vector<IndicatorsWorst>& _worst, Kernel&& _kernel) const
+{
+    _partials.assign(n_chunks(_n) * _n_values, Reduction());
+    _distributions.assign(_n_values, distribution());
+
+    const std::vector<IndicatorsWorst> empty(_worst);
+
+    std::mutex mutex;
+    for_each_chunk(_n, [&](const size_t _chunk, const size_t _begin, const size_t _end)
+    {
+        Reduction* reductions = &_partials[_chunk * _n_values];
+        for (size_t k(0); k < _n_values; ++k)
+        {
+            reductions[k].distribution = distribution();
+            reductions[k].worst = empty[k];
+        }
+
+        if (!_worst.empty() && _worst.front().enabled())
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t k(0); k < _n_values; ++k)
+            {
+                reductions[k].worst.limit(_worst[k]);
+            }
+        }
+
+        _kernel(_chunk, _begin, _end, reductions);
+
+        // the distributions only count values and the worst faces are ordered by value and index, the sums do not
+        // depend on the order of the chunks
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t k(0); k < _n_values; ++k)
+        {
+            _distributions[k].merge(reductions[k].distribution);
+            reductions[k].distribution = IndicatorsDistribution();
+            _worst[k].merge(reductions[k].worst);
+            reductions[k].worst = IndicatorsWorst();
+        }
+    });
+}
+
+template<class Values>
+void Indicators::collect_worst(const size_t _n, const Values& _values, IndicatorsWorst& _worst) const
+{
+    _worst.clear();
+    if (!_worst.enabled())
+        return;
+
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::WORST);
+    const IndicatorsWorst empty(_worst);
+
+    std::mutex mutex;
+    for_each_chunk(_n, [&](const size_t, const size_t _begin, const size_t _end)
+    {
+        IndicatorsWorst chunk(empty);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunk.limit(_worst);
+        }
+
+        for (size_t f(_begin); f < _end; ++f)
+        {
+            chunk.add(static_cast<unsigned int>(f), _values[f]);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        _worst.merge(chunk);
+    });
+}
+
+template<class MeshT>
+void Indicators::select_faces(MeshT& _mesh, const IndicatorsWorst& _worst) const
+{
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::SELECT);
+
+    for_each_chunk(_mesh.n_faces(), [&](const size_t, const size_t _begin, const size_t _end)
+    {
+        for (size_t f(_begin); f < _end; ++f)
+        {
+            _mesh.status(_mesh.face_handle(f)).set_selected(false);
+        }
+    });
+
+    for (const auto& face: _worst.faces())
+    {
+        _mesh.status(_mesh.face_handle(face.face)).set_selected(true);
+    }
+}
+
+template<class MeshT>
+uint64_t Indicators::content_hash(const MeshT& _mesh) const
+{
+    static_assert(chunk_size == IndicatorsColumns::chunk_size, "the hash is folded over the chunks of the loops");
+
+    const size_t n_vertices = _mesh.n_vertices();
+    const size_t n_faces = snapshot_.n_faces();
+
+    std::vector<uint64_t> points(n_chunks(n_vertices));
+    for_each_chunk(n_vertices, [&](const size_t _chunk, const size_t _begin, const size_t _end)
+    {
+        IndicatorsColumns::Hash h;
+        for (size_t v(_begin); v < _end; ++v)
+        {
+            const auto& p = _mesh.point(_mesh.vertex_handle(v));
+            h.add(double(p[0]));
+            h.add(double(p[1]));
+            h.add(double(p[2]));
+        }
+        points[_chunk] = h.value();
+    });
+
+    std::vector<uint64_t> faces(n_chunks(n_faces));
+    for_each_chunk(n_faces, [&](const size_t _chunk, const size_t _begin, const size_t _end)
+    {
+        IndicatorsColumns::Hash h;
+        for (size_t f(_begin); f < _end; ++f)
+        {
+            const unsigned int* face = snapshot_.face(f);
+            const size_t valence = snapshot_.valence(f);
+
+            h.add(static_cast<uint64_t>(valence));
+            for (size_t i(0); i < valence; ++i)
+            {
+                h.add(static_cast<uint64_t>(face[i]));
+            }
+        }
+        faces[_chunk] = h.value();
+    });
+
+    return IndicatorsColumns::hash(n_vertices, n_faces, points, faces);
+}
+
+template<class MeshT>
+bool Indicators::export_columns(MeshT& _mesh, const std::string& _path)
+{
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::COLUMNS);
+
+    // the indicators whose values match the mesh, edits since their evaluation are in the log
+    std::vector<indicatorsType::indicators> columns;
+    for (auto i: indicatorsType::all())
+    {
+        const State& state = states_[i];
+        if (state.valid && state.log_position == modified_faces_.size() && (face_double_[i].is_valid() || face_float_[i].is_valid()))
+            columns.push_back(i);
+    }
+
+    const size_t n_faces = _mesh.n_faces();
+    const uint32_t precision = single_precision_ ? sizeof(float) : sizeof(double);
+
+    IndicatorsColumns::Writer writer;
+    if (columns.empty() || !writer.create(_path, n_faces, precision, columns))
+        return false;
+
+    // written column by column through a buffer of one chunk, the file may not fit in memory twice
+    std::vector<char> buffer(chunk_size * precision);
+    for (size_t c(0); c < columns.size(); ++c)
+    {
+        const FaceValues<MeshT> values = face_values(_mesh, columns[c]);
+        for (size_t begin(0); begin < n_faces; begin += chunk_size)
+        {
+            const size_t n = std::min(chunk_size, n_faces - begin);
+            for (size_t i(0); i < n; ++i)
+            {
+                if (single_precision_)
+                    reinterpret_cast<float*>(buffer.data())[i] = static_cast<float>(values[begin + i]);
+                  else
+                    reinterpret_cast<double*>(buffer.data())[i] = values[begin + i];
+            }
+
+            if (!writer.write(c, begin, buffer.data(), n))
+                return false;
+        }
+    }
+
+    return writer.finish(content_hash(_mesh));
+}
+
+template<class MeshT>
+bool Indicators::load_columns(MeshT& _mesh, const std::string& _path)
+{
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::COLUMNS);
+
+    IndicatorsColumns file;
+    if (!file.open(_path) || file.n_faces() != _mesh.n_faces() || file.header().hash != content_hash(_mesh))
+        return false;
+
+    std::vector<indicatorsType::indicators> loaded;
+    for (auto i: file.indicators())
+    {
+        const bool property = face_double_[i].is_valid() || face_float_[i].is_valid();
+        if (property && std::find(loaded.begin(), loaded.end(), i) == loaded.end())
+            loaded.push_back(i);
+    }
+
+    if (loaded.empty())
+        return false;
+
+    std::vector<FaceValues<MeshT>> values;
+    std::vector<IndicatorsWorst> worst;
+    for (auto i: loaded)
+    {
+        values.push_back(face_values(_mesh, i));
+        worst.push_back(this->worst(i));
+        states_[i].valid = false;
+    }
+
+    // copied in place, the values are converted when the file has the other precision, and reduced as an
+    // evaluation would have
+    const bool floats = file.header().precision == sizeof(float);
+    const size_t n_values = loaded.size();
+    std::vector<Reduction> partials;
+    std::vector<IndicatorsDistribution> distributions;
+
+    reduce_chunks(_mesh.n_faces(), n_values, partials, distributions, worst,
+        [&](const size_t, const size_t _begin, const size_t _end, Reduction* _reductions)
+    {
+        for (size_t k(0); k < n_values; ++k)
+        {
+            const char* column = static_cast<const char*>(file.column(loaded[k]));
+            for (size_t f(_begin); f < _end; ++f)
+            {
+                double value;
+                if (floats)
+                {
+                    float v;
+                    std::memcpy(&v, column + f * sizeof(float), sizeof(float));
+                    value = v;
+                }
+                  else
+                {
+                    std::memcpy(&value, column + f * sizeof(double), sizeof(double));
+                }
+
+                _reductions[k].add(f, values[k].set(f, value));
+            }
+        }
+    });
+
+    if (cancelled_)
+        return false;
+
+    store_states(loaded, partials, distributions, worst);
+    return true;
+}
+
+//====================================================================================================================//
+template<class Source, class Store, class... Is>
+bool Indicators::evaluate_triangles(indicatorsRegistry::List<Is...> _list, const Source& _source, const size_t _begin,
+    const size_t _end, const indicatorsSimd::Kernel _kernel, const Request& _request, Store&& _store) const
+{
+    const std::vector<indicatorsType::indicators>& active = _request.active;
+
+    const bool cached = _source.cached();
+    const size_t n_inputs = cached ? 15 : 9;
+
+    // 9 coordinate arrays, the squared lengths and lengths of the 3 edges with the edge cache, followed by
+    // one value array per active indicator
+    std::vector<double> buffer((n_inputs + active.size()) * block_size);
+
+    indicatorsSimd::Triangles batch;
+    for (size_t c(0); c < 9; ++c)
+    {
+        batch.c[c] = &buffer[c * block_size];
+    }
+
+    if (cached)
+    {
+        for (size_t e(0); e < 3; ++e)
+        {
+            batch.sqr_e[e] = &buffer[(9 + e) * block_size];
+            batch.e[e] = &buffer[(12 + e) * block_size];
+        }
+    }
+
+    indicatorsSimd::Values values = {nullptr, nullptr, nullptr, nullptr};
+    double** outputs[indicatorsType::n_indicators];
+    indicatorsRegistry::batched_outputs(_list, values, outputs);
+
+    std::vector<const double*> kernel_values(active.size(), nullptr);
+    bool need_kernel(false), need_scalar(false);
+    for (size_t k(0); k < active.size(); ++k)
+    {
+        if (double** output = outputs[active[k]])
+        {
+            kernel_values[k] = *output = &buffer[(n_inputs + k) * block_size];
+            need_kernel = true;
+        }
+          else
+        {
+            need_scalar = true;
+        }
+    }
+
+    double scalar_values[indicatorsType::n_indicators];
+
+    for (size_t b(_begin); b < _end; b += block_size)
+    {
+        const size_t n = std::min(_end - b, size_t(block_size));
+
+        indicatorsRegistry::Triangle tr;
+        for (size_t i(0); i < n; ++i)
+        {
+            if (!_source.triangle(b + i, tr))
+                return false;
+
+            for (size_t c(0); c < 3; ++c)
+            {
+                buffer[c * block_size + i] = tr.v0[c];
+                buffer[(3 + c) * block_size + i] = tr.v1[c];
+                buffer[(6 + c) * block_size + i] = tr.v2[c];
+            }
+        }
+
+        if (cached && need_kernel)
+        {
+            for (size_t i(0); i < n; ++i)
+            {
+                double sqr_e[3], e[3];
+                _source.edges(b + i, sqr_e, e);
+                for (size_t j(0); j < 3; ++j)
+                {
+                    buffer[(9 + j) * block_size + i] = sqr_e[j];
+                    buffer[(12 + j) * block_size + i] = e[j];
+                }
+            }
+        }
+
+        if (need_kernel)
+        {
+            // lanes past n hold the previous block, their values are ignored
+            batch.n = (n + indicatorsSimd::padding - 1) / indicatorsSimd::padding * indicatorsSimd::padding;
+            _kernel(batch, values);
+        }
+
+        for (size_t i(0); i < n; ++i)
+        {
+            if (need_scalar)
+            {
+                tr = {
+                    Point(buffer[i], buffer[block_size + i], buffer[2 * block_size + i]),
+                    Point(buffer[3 * block_size + i], buffer[4 * block_size + i], buffer[5 * block_size + i]),
+                    Point(buffer[6 * block_size + i], buffer[7 * block_size + i], buffer[8 * block_size + i])};
+
+                indicatorsRegistry::evaluate(_list, tr, _request.slots, scalar_values);
+            }
+
+            for (size_t k(0); k < active.size(); ++k)
+            {
+                _store(b + i, k, kernel_values[k] ? kernel_values[k][i] : scalar_values[k]);
+            }
+        }
+    }
+
+    return true;
+}
+
+template<class Source, class Store, class... Is>
+bool Indicators::evaluate_polygons(indicatorsRegistry::List<Is...> _list, const Source& _source, const size_t _begin,
+    const size_t _end, const unsigned int* _order, const unsigned int _seed, indicatorsRegistry::Workspace& _workspace,
+    const Request& _request, Store&& _store) const
+{
+    std::vector<Point>& points = _workspace.points;
+    double values[indicatorsType::n_indicators];
+
+    _workspace.enclosing.reset_counters();
+
+    bool valid(true);
+    for (size_t j(_begin); j < _end; ++j)
+    {
+        const size_t i = _order ? _begin + _order[j - _begin] : j;
+        if (!_source.polygon(i, points))
+        {
+            valid = false;
+            break;
+        }
+
+        const size_t f = _source.face(i);
+        _workspace.rng.seed(_seed ^ static_cast<unsigned int>(f * 2654435761u));
+        _workspace.decomposed = false;
+
+        const indicatorsRegistry::Polygon polygon = {points.data(), points.size(), &_workspace};
+        indicatorsRegistry::evaluate(_list, polygon, _request.slots, values);
+
+        for (size_t k(0); k < _request.active.size(); ++k)
+        {
+            _store(i, k, values[k]);
+        }
+    }
+
+    profile_.add(IndicatorsProfile::WELZL_CALLS, _workspace.enclosing.welzl_calls());
+    profile_.raise(IndicatorsProfile::WELZL_DEPTH, _workspace.enclosing.welzl_depth());
+
+    return valid;
+}
+
+template<class MeshT, class Kernel>
+std::vector<Indicators::Reduction> Indicators::evaluate(MeshT& _mesh,
+    const std::vector<indicatorsType::indicators>& _indicators, Kernel&& _kernel)
+{
+    const size_t n_faces = _mesh.n_faces();
+    const size_t n_values = _indicators.size();
+    const size_t chunks = n_chunks(n_faces);
+
+    bool full = false;
+    size_t from = modified_faces_.size();
+    for (auto i: _indicators)
+    {
+        const State& state = states_[i];
+        if (!state.valid || state.chunks.size() != chunks)
+            full = true;
+          else
+            from = std::min(from, state.log_position);
+    }
+
+    // up to date indicators are reused even when not incremental, a large edit is cheaper as a full pass
+    // than as scattered faces
+    const size_t modified = modified_faces_.size() - from;
+    if ((modified && !incremental_) || modified > n_faces / 4)
+        full = true;
+
+    std::vector<Reduction> partials;
+    std::vector<IndicatorsDistribution> distributions;
+
+    std::vector<IndicatorsWorst> worst;
+    for (auto i: _indicators)
+    {
+        worst.push_back(this->worst(i));
+    }
+
+    if (full)
+    {
+        const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::KERNELS);
+        profile_.add(IndicatorsProfile::FACES, n_faces);
+
+        reduce_chunks(n_faces, n_values, partials, distributions, worst,
+            [&](const size_t _chunk, const size_t _begin, const size_t _end, Reduction* _reductions)
+        {
+            const Faces faces = {_chunk, _begin, nullptr, _end - _begin};
+            _kernel(faces, _reductions);
+        });
+    }
+      else
+    {
+        partials.resize(chunks * n_values);
+        for (size_t k(0); k < n_values; ++k)
+        {
+            const State& state = states_[_indicators[k]];
+            for (size_t c(0); c < chunks; ++c)
+            {
+                partials[c * n_values + k] = state.chunks[c];
+            }
+        }
+
+        std::vector<unsigned int> dirty(modified_faces_.begin() + from, modified_faces_.end());
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        // start of the dirty faces of each touched chunk
+        std::vector<size_t> groups;
+        for (size_t d(0); d < dirty.size(); ++d)
+        {
+            if (d == 0 || dirty[d] / chunk_size != dirty[d-1] / chunk_size)
+                groups.push_back(d);
+        }
+        groups.push_back(dirty.size());
+
+        std::vector<FaceValues<MeshT>> values;
+        for (auto i: _indicators)
+        {
+            values.push_back(face_values(_mesh, i));
+        }
+
+        // the previous values of the dirty faces leave the distributions and their new values enter them, the
+        // same for the worst faces
+        std::vector<IndicatorsDistribution> removed(n_values, distribution());
+        std::vector<IndicatorsDistribution> added(n_values, distribution());
+        std::mutex mutex;
+
+        const std::vector<IndicatorsWorst> empty(worst);
+        for (size_t k(0); k < n_values; ++k)
+        {
+            const IndicatorsWorst& previous = states_[_indicators[k]].worst;
+            if (previous.same_query(worst[k]))
+            {
+                worst[k] = previous;
+                worst[k].remove(dirty);
+            }
+        }
+
+        IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::KERNELS);
+        profile_.add(IndicatorsProfile::FACES, dirty.size());
+
+        for_each(groups.size() - 1, [&](const size_t _g)
+        {
+            const size_t chunk = dirty[groups[_g]] / chunk_size;
+            const Faces faces = {chunk, 0, &dirty[groups[_g]], groups[_g + 1] - groups[_g]};
+
+            std::vector<IndicatorsDistribution> group_removed(n_values, distribution());
+            std::vector<IndicatorsDistribution> group_added(n_values, distribution());
+            std::vector<IndicatorsWorst> group_worst(empty);
+            for (size_t k(0); k < n_values; ++k)
+            {
+                for (size_t i(0); i < faces.n; ++i)
+                {
+                    group_removed[k].add(values[k][faces[i]]);
+                }
+            }
+
+            _kernel(faces, nullptr);
+
+            const size_t end = std::min(n_faces, (chunk + 1) * chunk_size);
+            for (size_t k(0); k < n_values; ++k)
+            {
+                for (size_t i(0); i < faces.n; ++i)
+                {
+                    group_added[k].add(values[k][faces[i]]);
+                    group_worst[k].add(faces[i], values[k][faces[i]]);
+                }
+
+                Reduction r;
+                for (size_t f(chunk * chunk_size); f < end; ++f)
+                {
+                    r.accumulate(values[k][f]);
+                }
+                partials[chunk * n_values + k] = r;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            for (size_t k(0); k < n_values; ++k)
+            {
+                removed[k].merge(group_removed[k]);
+                added[k].merge(group_added[k]);
+                worst[k].merge(group_worst[k]);
+            }
+        });
+
+        timer.stop();
+
+        for (size_t k(0); k < n_values; ++k)
+        {
+            distributions.push_back(states_[_indicators[k]].distribution);
+            distributions[k].merge(added[k]);
+            distributions[k].subtract(removed[k]);
+
+            // a new query, or a kept face got better while others were left out for the bound
+            if (!worst[k].complete() || !states_[_indicators[k]].worst.same_query(worst[k]))
+                collect_worst(n_faces, values[k], worst[k]);
+        }
+    }
+
+    std::vector<Reduction> reductions(n_values);
+    for (size_t p(0); p < partials.size(); ++p)
+    {
+        reductions[p % n_values].merge(partials[p]);
+    }
+
+    for (size_t k(0); k < n_values; ++k)
+    {
+        reductions[k].distribution = distributions[k];
+        reductions[k].worst = worst[k];
+    }
+
+    // some chunks were skipped and some properties may be half written
+    if (cancelled_)
+    {
+        for (auto i: _indicators)
+        {
+            states_[i].valid = false;
+        }
+        return reductions;
+    }
+
+    store_states(_indicators, partials, distributions, worst);
+
+    // drops the part of the log every valid indicator has seen
+    size_t seen = modified_faces_.size();
+    for (const State& state: states_)
+    {
+        if (state.valid)
+            seen = std::min(seen, state.log_position);
+    }
+
+    modified_faces_.erase(modified_faces_.begin(), modified_faces_.begin() + seen);
+    for (State& state: states_)
+    {
+        state.log_position = state.valid ? state.log_position - seen : 0;
+    }
+
+    return reductions;
+}
+
+template<class MeshT>
+void Indicators::sync_properties(MeshT& _mesh)
+{
+    for (auto i: indicatorsType::all())
+    {
+        OpenMesh::FPropHandleT<double>& double_property = face_double_[i];
+        OpenMesh::FPropHandleT<float>& float_property = face_float_[i];
+
+        if (single_precision_ && double_property.is_valid())
+        {
+            _mesh.add_property(float_property, _mesh.property(double_property).name());
+            _mesh.remove_property(double_property);
+            invalidate_indicators();
+        }
+          else if (!single_precision_ && float_property.is_valid())
+        {
+            _mesh.add_property(double_property, _mesh.property(float_property).name());
+            _mesh.remove_property(float_property);
+            invalidate_indicators();
+        }
+    }
+}
+
+template<class Element, class MeshT>
+void Indicators::add_properties(MeshT& _mesh)
+{
+    bool defined[indicatorsType::n_indicators];
+    indicatorsRegistry::defined<Element>(indicatorsRegistry::All(), defined);
+
+    for (const auto& entry: indicatorsRegistry::entries())
+    {
+        if (defined[entry.id])
+            _mesh.add_property(face_double_[entry.id], entry.property);
+    }
+}
+
+template<class MeshT>
+void Indicators::remove_properties(MeshT& _mesh)
+{
+    for (auto i: indicatorsType::all())
+    {
+        _mesh.remove_property(face_double_[i]);
+        _mesh.remove_property(face_float_[i]);
+    }
+}
+
+template<class MeshT>
+void Indicators::sync_snapshot(const MeshT& _mesh, const unsigned int _arity)
+{
+    std::vector<unsigned int> moved;
+    moved.swap(moved_vertices_);
+
+    const bool changed = geometry_changed_;
+    geometry_changed_ = false;
+
+    if (!snapshot_.valid_for(_mesh))
+    {
+        snapshot_.build(_mesh, _arity);
+        invalidate_indicators();
+        return;
+    }
+
+    if (changed)
+    {
+        moved.clear();
+        snapshot_.update_points(_mesh, moved);
+    }
+      else
+    {
+        snapshot_.update_points(_mesh, moved.data(), moved.size());
+    }
+
+    const size_t from = modified_faces_.size();
+    for (auto v: moved)
+    {
+        for (auto vf_iter = _mesh.cvf_iter(_mesh.vertex_handle(v)); vf_iter.is_valid(); ++vf_iter)
+        {
+            modified_faces_.push_back((*vf_iter).idx());
+        }
+    }
+
+    snapshot_.update_edges(modified_faces_.data() + from, modified_faces_.size() - from);
+
+    // past this size a full pass is cheaper for every indicator
+    if (modified_faces_.size() > _mesh.n_faces())
+        invalidate_indicators();
+}
+
 #endif // INDICATORS_HH
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "IndicatorsColumns.hh"
+
+namespace
+{
+    const char magic[8] = {'I', 'C', 'O', 'L', 'U', 'M', 'N', 'S'};
+
+    uint64_t aligned(const uint64_t _offset)
+    {
+        return (_offset + IndicatorsColumns::alignment - 1) / IndicatorsColumns::alignment * IndicatorsColumns::alignment;
+    }
+}
+
+uint64_t IndicatorsColumns::hash(const size_t _n_vertices, const size_t _n_faces,
+    const std::vector<uint64_t>& _point_chunks, const std::vector<uint64_t>& _face_chunks)
+{
+    Hash h;
+    h.add(static_cast<uint64_t>(_n_vertices));
+    h.add(static_cast<uint64_t>(_n_faces));
+
+    for (auto c: _point_chunks)
+    {
+        h.add(c);
+    }
+
+    for (auto c: _face_chunks)
+    {
+        h.add(c);
+    }
+
+    return h.value();
+}
+
+//====================================================================================================================//
+bool IndicatorsColumns::Writer::create(const std::string& _path, const size_t _n_faces, const uint32_t _precision,
+    const std::vector<indicatorsType::indicators>& _columns)
+{
+    out_.close();
+    out_.clear();
+    if (!little_endian())
+        return false;
+
+    out_.open(_path, std::ios::binary | std::ios::trunc);
+    if (!out_)
+        return false;
+
+    std::memcpy(header_.magic, magic, sizeof(magic));
+    header_.version = 1;
+    header_.precision = _precision;
+    header_.n_faces = _n_faces;
+    header_.hash = 0;
+    header_.n_columns = static_cast<uint32_t>(_columns.size());
+    header_.reserved = 0;
+
+    columns_.clear();
+    uint64_t offset = aligned(sizeof(Header) + _columns.size() * sizeof(Column));
+    for (auto i: _columns)
+    {
+        columns_.push_back(Column{static_cast<uint32_t>(i), 0, offset});
+        offset = aligned(offset + _n_faces * _precision);
+    }
+
+    // the file has its final size from the start, the columns are written in any order
+    if (offset > 0)
+    {
+        out_.seekp(static_cast<std::streamoff>(offset - 1));
+        out_.put(0);
+    }
+
+    return static_cast<bool>(out_);
+}
+
+bool IndicatorsColumns::Writer::write(const size_t _c, const size_t _begin, const void* _values, const size_t _n)
+{
+    out_.seekp(static_cast<std::streamoff>(columns_[_c].offset + _begin * header_.precision));
+    out_.write(static_cast<const char*>(_values), _n * header_.precision);
+    return static_cast<bool>(out_);
+}
+
+bool IndicatorsColumns::Writer::finish(const uint64_t _hash)
+{
+    header_.hash = _hash;
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    out_.write(reinterpret_cast<const char*>(columns_.data()), columns_.size() * sizeof(Column));
+    out_.close();
+
+    return static_cast<bool>(out_);
+}
+
+//====================================================================================================================//
+bool IndicatorsColumns::open(const std::string& _path)
+{
+    if (!little_endian() || !file_.open(_path) || file_.size() < sizeof(Header))
+    {
+        file_.close();
+        return false;
+    }
+
+    const Header& h = header();
+    bool valid = std::memcmp(h.magic, magic, sizeof(magic)) == 0 && h.version == 1
+        && (h.precision == sizeof(float) || h.precision == sizeof(double))
+        && h.n_columns <= (file_.size() - sizeof(Header)) / sizeof(Column)
+        && h.n_faces <= file_.size() / h.precision;
+
+    // every column inside the file, at an aligned offset
+    for (uint32_t c(0); valid && c < h.n_columns; ++c)
+    {
+        const Column& column = directory()[c];
+        valid = column.id < indicatorsType::n_indicators && column.offset % alignment == 0
+            && column.offset <= file_.size() && h.n_faces * h.precision <= file_.size() - column.offset;
+    }
+
+    if (!valid)
+        file_.close();
+
+    return valid;
+}
+
+const void* IndicatorsColumns::column(const indicatorsType::indicators& _i) const
+{
+    if (!is_open())
+        return nullptr;
+
+    for (uint32_t c(0); c < header().n_columns; ++c)
+    {
+        if (directory()[c].id == static_cast<uint32_t>(_i))
+            return file_.data() + directory()[c].offset;
+    }
+
+    return nullptr;
+}
+
+double IndicatorsColumns::value(const indicatorsType::indicators& _i, const size_t _f) const
+{
+    const char* values = static_cast<const char*>(column(_i));
+    if (!values || _f >= n_faces())
+        return 0.0;
+
+    if (header().precision == sizeof(float))
+    {
+        float v;
+        std::memcpy(&v, values + _f * sizeof(float), sizeof(float));
+        return v;
+    }
+
+    double v;
+    std::memcpy(&v, values + _f * sizeof(double), sizeof(double));
+    return v;
+}
+
+std::vector<indicatorsType::indicators> IndicatorsColumns::indicators() const
+{
+    std::vector<indicatorsType::indicators> ids;
+    for (uint32_t c(0); is_open() && c < header().n_columns; ++c)
+    {
+        ids.push_back(static_cast<indicatorsType::indicators>(directory()[c].id));
+    }
+    return ids;
+}
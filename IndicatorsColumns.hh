@@ -0,0 +1,135 @@
+#ifndef INDICATORS_COLUMNS_HH
+#define INDICATORS_COLUMNS_HH
+
+#include "IndicatorsMapped.hh"
+#include "IndicatorsType.hh"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// file of per-face values, one contiguous array per indicator so that a reader maps the file and uses the values
+// in place, without parsing. little endian, the arrays start on page boundaries. the file is used in the byte
+// order of the host, it cannot be written or opened on a big endian host:
+//
+//   header     "ICOLUMNS", uint32 version 1, uint32 precision (bytes per value, 4 for float, 8 for double),
+//              uint64 faces, uint64 content hash of the mesh, uint32 columns, uint32 0
+//   directory  per column: uint32 indicator id, uint32 0, uint64 offset of its values in the file
+//   values     faces floats or doubles per column
+//
+// the values of a face belong to the mesh of the content hash, see Hash
+class IndicatorsColumns
+{
+public:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t precision;
+        uint64_t n_faces;
+        uint64_t hash;
+        uint32_t n_columns;
+        uint32_t reserved;
+    };
+
+    struct Column
+    {
+        uint32_t id;
+        uint32_t reserved;
+        uint64_t offset;
+    };
+
+    static constexpr size_t alignment = 4096;
+
+    // the files of the indicators are little endian and used in place, only such a host reads or writes them
+    static bool little_endian()
+    {
+        const uint32_t word = 1;
+        unsigned char first;
+        std::memcpy(&first, &word, 1);
+        return first == 1;
+    }
+
+    // content hash of a mesh: the vertex and face counts, then the hash of every chunk of chunk_size points,
+    // from their double coordinates, then of every chunk of chunk_size faces, from their valence and vertex
+    // indices. the chunks are hashed on their own and folded in order, in parallel and by streamed blocks alike
+    class Hash
+    {
+    public:
+        Hash(): h_(0x9e3779b97f4a7c15ull) {}
+
+        void add(const uint64_t _word)
+        {
+            h_ ^= _word * 0xff51afd7ed558ccdull;
+            h_ = ((h_ << 31) | (h_ >> 33)) * 0xc4ceb9fe1a85ec53ull;
+        }
+
+        void add(const double _value)
+        {
+            uint64_t word;
+            std::memcpy(&word, &_value, sizeof(word));
+            add(word);
+        }
+
+        uint64_t value() const { return h_ ^ (h_ >> 29); }
+
+    private:
+        uint64_t h_;
+    };
+
+    static constexpr size_t chunk_size = 4096;
+
+    // hash of the mesh from the hashes of its chunks of points and of faces
+    static uint64_t hash(const size_t _n_vertices, const size_t _n_faces, const std::vector<uint64_t>& _point_chunks,
+        const std::vector<uint64_t>& _face_chunks);
+
+    // writes a file column by column or block by block, the header is written last by finish()
+    class Writer
+    {
+    public:
+        // _columns arrays of _n_faces values of _precision bytes, false on a big endian host
+        bool create(const std::string& _path, const size_t _n_faces, const uint32_t _precision,
+            const std::vector<indicatorsType::indicators>& _columns);
+
+        // _n values of column _c from face _begin, in the precision of the file
+        bool write(const size_t _c, const size_t _begin, const void* _values, const size_t _n);
+
+        bool finish(const uint64_t _hash);
+
+    private:
+        std::ofstream out_;
+        Header header_;
+        std::vector<Column> columns_;
+    };
+
+public:
+    // maps a file, false when it is not one or the host is big endian
+    bool open(const std::string& _path);
+
+    void close() { file_.close(); }
+
+    bool is_open() const { return file_.is_open(); }
+
+    const Header& header() const { return *reinterpret_cast<const Header*>(file_.data()); }
+
+    size_t n_faces() const { return is_open() ? header().n_faces : 0; }
+
+    // values of _i in place in the mapping, nullptr when the file has none
+    const void* column(const indicatorsType::indicators& _i) const;
+
+    // value of _i on face _f, 0 when the file has none
+    double value(const indicatorsType::indicators& _i, const size_t _f) const;
+
+    // indicators of the file
+    std::vector<indicatorsType::indicators> indicators() const;
+
+private:
+    const Column* directory() const { return reinterpret_cast<const Column*>(file_.data() + sizeof(Header)); }
+
+private:
+    IndicatorsMapped file_;
+};
+
+#endif // INDICATORS_COLUMNS_HH
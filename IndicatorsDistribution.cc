@@ -0,0 +1,154 @@
+#include "IndicatorsDistribution.hh"
+
+#include <algorithm>
+#include <cmath>
+
+IndicatorsDistribution::IndicatorsDistribution(const size_t _bins, const double _lo, const double _hi):
+lo_(_lo), hi_(_hi), inv_width_(_hi > _lo ? _bins / (_hi - _lo) : 0.0), bins_(_bins, 0),
+below_(0), above_(0), zeros_(0), offset_(0), n_(0)
+{
+}
+
+//====================================================================================================================//
+double IndicatorsDistribution::bucket_value(const int _bucket)
+{
+    if (_bucket == zero_bucket)
+        return 0.0;
+
+    // middle of the bucket, floor division for the negative exponents
+    const int exponent = (_bucket >= 0) ? _bucket >> mantissa_bits : -((-_bucket - 1) >> mantissa_bits) - 1;
+    const int mantissa = _bucket - exponent * (1 << mantissa_bits);
+
+    return std::ldexp(1.0 + (mantissa + 0.5) / (1 << mantissa_bits), exponent);
+}
+
+void IndicatorsDistribution::grow(const int _bucket)
+{
+    if (buckets_.empty())
+    {
+        offset_ = _bucket;
+        buckets_.assign(1, 0);
+        return;
+    }
+
+    if (_bucket < offset_)
+    {
+        buckets_.insert(buckets_.begin(), offset_ - _bucket, 0);
+        offset_ = _bucket;
+    }
+      else if (_bucket >= offset_ + static_cast<int>(buckets_.size()))
+    {
+        buckets_.resize(_bucket - offset_ + 1, 0);
+    }
+}
+
+//====================================================================================================================//
+void IndicatorsDistribution::merge(const IndicatorsDistribution& _d)
+{
+    // an empty distribution without bins takes the ones of the first merged into it
+    if (bins_.empty() && n_ == 0)
+    {
+        lo_ = _d.lo_;
+        hi_ = _d.hi_;
+        inv_width_ = _d.inv_width_;
+        bins_.assign(_d.bins_.size(), 0);
+    }
+
+    n_ += _d.n_;
+    zeros_ += _d.zeros_;
+
+    if (bins_.size() == _d.bins_.size())
+    {
+        for (size_t i(0); i < bins_.size(); ++i)
+        {
+            bins_[i] += _d.bins_[i];
+        }
+        below_ += _d.below_;
+        above_ += _d.above_;
+    }
+
+    if (_d.buckets_.empty())
+        return;
+
+    grow(_d.offset_);
+    grow(_d.offset_ + static_cast<int>(_d.buckets_.size()) - 1);
+    for (size_t i(0); i < _d.buckets_.size(); ++i)
+    {
+        buckets_[_d.offset_ - offset_ + i] += _d.buckets_[i];
+    }
+}
+
+void IndicatorsDistribution::subtract(const IndicatorsDistribution& _d)
+{
+    n_ -= _d.n_;
+    zeros_ -= _d.zeros_;
+
+    if (bins_.size() == _d.bins_.size())
+    {
+        for (size_t i(0); i < bins_.size(); ++i)
+        {
+            bins_[i] -= _d.bins_[i];
+        }
+        below_ -= _d.below_;
+        above_ -= _d.above_;
+    }
+
+    for (size_t i(0); i < _d.buckets_.size(); ++i)
+    {
+        buckets_[_d.offset_ - offset_ + i] -= _d.buckets_[i];
+    }
+}
+
+//====================================================================================================================//
+double IndicatorsDistribution::quantile(const double _q) const
+{
+    if (n_ == 0)
+        return 0.0;
+
+    // rank of the value, nearest rank on the sorted values
+    const size_t rank = static_cast<size_t>(std::min(1.0, std::max(0.0, _q)) * (n_ - 1));
+
+    size_t seen = zeros_;
+    if (rank < seen)
+        return 0.0;
+
+    for (size_t i(0); i < buckets_.size(); ++i)
+    {
+        seen += buckets_[i];
+        if (rank < seen)
+            return bucket_value(offset_ + static_cast<int>(i));
+    }
+
+    return bucket_value(offset_ + static_cast<int>(buckets_.size()) - 1);
+}
+
+size_t IndicatorsDistribution::count_below(const double _value) const
+{
+    // the histogram is exact when _value is one of its bounds
+    if (!bins_.empty() && _value >= lo_ && _value <= hi_)
+    {
+        const double position = (_value - lo_) * inv_width_;
+        const size_t bin = static_cast<size_t>(std::lround(position));
+        if (std::abs(position - bin) < 1e-9)
+        {
+            size_t count = below_;
+            for (size_t i(0); i < bin; ++i)
+            {
+                count += bins_[i];
+            }
+            return count;
+        }
+    }
+
+    if (!(_value > 0))
+        return 0;
+
+    // whole buckets below the one holding _value
+    size_t count = zeros_;
+    const int last = bucket(_value);
+    for (size_t i(0); i < buckets_.size() && offset_ + static_cast<int>(i) < last; ++i)
+    {
+        count += buckets_[i];
+    }
+    return count;
+}
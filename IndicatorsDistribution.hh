@@ -0,0 +1,139 @@
+#ifndef INDICATORS_DISTRIBUTION_HH
+#define INDICATORS_DISTRIBUTION_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// distribution of the values of an indicator, built in the same loop as min/max/average:
+// a histogram with fixed bins over [lo, hi], and a quantile sketch counting the values in logarithmic buckets,
+// 128 per power of two, so a quantile is within 0.4% of the true value. both only hold counts, they merge and
+// remove values exactly and in any order, and their memory is bounded by the bins and the exponent range
+class IndicatorsDistribution
+{
+public:
+    // without bins only the quantile sketch is kept
+    IndicatorsDistribution(const size_t _bins = 0, const double _lo = 0.0, const double _hi = 1.0);
+
+    void add(const double _value) { count(_value, 1); }
+
+    // _value must have been added before
+    void remove(const double _value) { count(_value, -1); }
+
+    // the histograms are only summed when both have the same bins
+    void merge(const IndicatorsDistribution&);
+
+    // every value of _d must have been added before, with the same bins
+    void subtract(const IndicatorsDistribution&);
+
+    // values counted, NaN are skipped
+    size_t size() const { return n_; }
+
+    // value at _q in [0, 1], 0 when empty
+    double quantile(const double _q) const;
+
+    // approximate number of values below _value, exact on the histogram bin bounds
+    size_t count_below(const double _value) const;
+
+public:
+    size_t n_bins() const { return bins_.size(); }
+
+    double bin_lo(const size_t _i) const { return lo_ + _i * (hi_ - lo_) / bins_.size(); }
+
+    double bin_hi(const size_t _i) const { return lo_ + (_i + 1) * (hi_ - lo_) / bins_.size(); }
+
+    size_t bin(const size_t _i) const { return bins_[_i]; }
+
+    // values outside of the bins
+    size_t below() const { return below_; }
+
+    size_t above() const { return above_; }
+
+private:
+    void count(const double _value, const long _delta);
+
+    // logarithmic bucket of a positive value, zero_bucket below the exponent range
+    static int bucket(const double _value);
+
+    static double bucket_value(const int _bucket);
+
+    void grow(const int _bucket);
+
+private:
+    static constexpr int mantissa_bits = 7;
+    static constexpr int min_exponent = -64;
+    static constexpr int max_exponent = 64;
+    static constexpr int zero_bucket = min_exponent * (1 << mantissa_bits) - 1;
+
+    double lo_;
+    double hi_;
+    double inv_width_;
+    std::vector<size_t> bins_;
+    size_t below_;
+    size_t above_;
+
+    // values not above zero or under the exponent range
+    size_t zeros_;
+
+    // buckets_[i] counts the bucket offset_ + i, only the range that has been used is allocated
+    int offset_;
+    std::vector<size_t> buckets_;
+
+    size_t n_;
+};
+
+//====================================================================================================================//
+// called for every value of the face loops
+inline int IndicatorsDistribution::bucket(const double _value)
+{
+    if (!(_value > 0))
+        return zero_bucket;
+
+    uint64_t bits;
+    std::memcpy(&bits, &_value, sizeof(bits));
+
+    // exponent and leading mantissa bits of the double
+    const int exponent = static_cast<int>((bits >> 52) & 0x7ff) - 1023;
+    const int mantissa = static_cast<int>((bits >> (52 - mantissa_bits)) & ((1 << mantissa_bits) - 1));
+
+    if (exponent < min_exponent)
+        return zero_bucket;
+    if (exponent >= max_exponent)
+        return max_exponent * (1 << mantissa_bits) - 1;
+
+    return exponent * (1 << mantissa_bits) + mantissa;
+}
+
+inline void IndicatorsDistribution::count(const double _value, const long _delta)
+{
+    if (std::isnan(_value))
+        return;
+
+    n_ += _delta;
+
+    if (!bins_.empty())
+    {
+        if (_value < lo_)
+            below_ += _delta;
+          else if (_value > hi_)
+            above_ += _delta;
+          else
+            bins_[std::min(bins_.size() - 1, static_cast<size_t>((_value - lo_) * inv_width_))] += _delta;
+    }
+
+    const int b = bucket(_value);
+    if (b == zero_bucket)
+    {
+        zeros_ += _delta;
+        return;
+    }
+
+    if (static_cast<size_t>(b - offset_) >= buckets_.size())
+        grow(b);
+    buckets_[b - offset_] += _delta;
+}
+
+#endif // INDICATORS_DISTRIBUTION_HH
@@ -0,0 +1,148 @@
+#include "IndicatorsEnclosing.hh"
+
+#include <ACG/Geometry/Algorithms.hh>
+
+#include <algorithm>
+#include <limits>
+
+bool IndicatorsEnclosing::inside(const Sphere& _s, const Point& _p)
+{
+    // relative slack so that rounding in the circumcenter does not push boundary points out
+    return (_s.center - _p).norm() <= _s.radius * (1.0 + 1e-10);
+}
+
+IndicatorsEnclosing::Sphere IndicatorsEnclosing::from_boundary(const Point* _b, const size_t _n)
+{
+    Sphere s;
+
+    switch(_n)
+    {
+        case 0:
+            s.radius = 0.0;
+            break; 
+        case 1:
+            s.radius = 0.0;
+            s.center = _b[0];
+            break; 
+        case 2:
+            s.radius = (_b[0] - _b[1]).norm() / 2.0;
+            s.center = (_b[0] + _b[1]) / 2.0;
+            break; 
+        case 3:
+            s.radius = ACG::Geometry::circumRadius(_b[0], _b[1], _b[2]);
+            ACG::Geometry::circumCenter(_b[0], _b[1], _b[2], s.center);
+            break;
+        case 4:
+            s.radius = ACG::Geometry::circumRadius(_b[0], _b[1], _b[2], _b[3]);
+            ACG::Geometry::circumCenter(_b[0], _b[1], _b[2], _b[3], s.center);
+            break;
+    }
+
+    return s;
+}
+
+IndicatorsEnclosing::Sphere IndicatorsEnclosing::radius(
+    Point* points,
+    const size_t n,
+    Point* boundary,
+    const size_t nb
+)
+{
+    // base on Welzl algorythm, move-to-front variant: only the boundary recurses, at most 4 levels deep,
+    // and the points are reordered in place
+    welzl_calls_++;
+    welzl_depth_ = std::max(welzl_depth_, nb);
+
+    Sphere s = from_boundary(boundary, nb);
+
+    if (nb == 4)
+        return s;
+
+    for (size_t i(0); i < n; ++i)
+    {
+        if (!inside(s, points[i]))
+        {
+            boundary[nb] = points[i];
+            s = radius(points, i, boundary, nb + 1);
+
+            std::rotate(points, points + i, points + i + 1);
+        }
+    }
+
+    return s;
+}
+
+IndicatorsEnclosing::Sphere IndicatorsEnclosing::small_radius(const Point* _p, const size_t _n)
+{
+    if (_n < 3)
+        return from_boundary(_p, _n);
+
+    if (_n == 3)
+    {
+        // obtuse triangles are enclosed by the sphere on their longest edge
+        for (size_t i(0); i < 3; ++i)
+        {
+            const Point& a = _p[i];
+            const Point& b = _p[(i+1) % 3];
+            const Point& c = _p[(i+2) % 3];
+
+            if (((b - a) | (c - a)) <= 0)
+            {
+                const Point edge[2] = {b, c};
+                return from_boundary(edge, 2);
+            }
+        }
+
+        return from_boundary(_p, 3);
+    }
+
+    // quad: smallest of the spheres on two or three of the points that encloses all four
+    Sphere best;
+    best.radius = std::numeric_limits<double>::max();
+
+    auto candidate = [&](const Sphere& _s)
+    {
+        if (_s.radius >= best.radius)
+            return;
+
+        for (size_t i(0); i < 4; ++i)
+        {
+            if (!inside(_s, _p[i]))
+                return;
+        }
+
+        best = _s;
+    };
+
+    for (size_t i(0); i < 4; ++i)
+    {
+        for (size_t j(i+1); j < 4; ++j)
+        {
+            const Point pair[2] = {_p[i], _p[j]};
+            candidate(from_boundary(pair, 2));
+        }
+
+        const Point triple[3] = {_p[(i+1) % 4], _p[(i+2) % 4], _p[(i+3) % 4]};
+        candidate(from_boundary(triple, 3));
+    }
+
+    if (best.radius == std::numeric_limits<double>::max())
+        best = from_boundary(_p, 4);
+
+    return best;
+}
+
+double IndicatorsEnclosing::radius(const Point* _points, const size_t _n, std::minstd_rand& _rng)
+{
+    if (_n <= 4)
+        return small_radius(_points, _n).radius;
+
+    // the shuffle and the move-to-front reorder a copy, the caller keeps the face order
+    points_.assign(_points, _points + _n);
+    std::shuffle(points_.begin(), points_.end(), _rng);
+
+    Point boundary[4];
+    Sphere cirumcircle = radius(points_.data(), _n, boundary, 0);
+
+    return cirumcircle.radius;
+}
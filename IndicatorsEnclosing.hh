@@ -0,0 +1,55 @@
+#ifndef INDICATORS_ENCLOSING_HH
+#define INDICATORS_ENCLOSING_HH
+
+#include <ACG/Math/VectorT.hh>
+
+#include <random>
+#include <vector>
+
+// smallest sphere enclosing the points of a polygon face
+//
+// up to 4 points: closed form, the obtuse triangles are enclosed by the sphere on their longest edge
+// more points: Welzl algorithm on the shuffled points, move-to-front variant, expected O(n) per face
+//
+// the points are copied into a buffer kept between calls, one instance per thread
+class IndicatorsEnclosing
+{
+public:
+    using Point = ACG::Vec3d;
+
+    IndicatorsEnclosing(): welzl_calls_(0), welzl_depth_(0) {}
+
+    double radius(const Point* _points, const size_t _n, std::minstd_rand& _rng);
+
+    // calls of the Welzl recursion and the deepest one, the size of its boundary, since the last reset
+    size_t welzl_calls() const { return welzl_calls_; }
+
+    size_t welzl_depth() const { return welzl_depth_; }
+
+    void reset_counters() { welzl_calls_ = 0; welzl_depth_ = 0; }
+
+private:
+    struct Sphere
+    {
+        Point center;
+        double radius;
+    };
+
+    static bool inside(const Sphere&, const Point&);
+
+    static Sphere from_boundary(const Point*, const size_t);
+
+    // reorders the points
+    Sphere radius(Point*, const size_t, Point*, const size_t);
+
+    // closed form smallest enclosing sphere of up to 4 points
+    static Sphere small_radius(const Point*, const size_t);
+
+private:
+    std::vector<Point> points_;
+
+    size_t welzl_calls_;
+    size_t welzl_depth_;
+};
+
+#endif // INDICATORS_ENCLOSING_HH
@@ -0,0 +1,290 @@
+#include "IndicatorsInscribed.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+double IndicatorsInscribed::radius(const Point* _points, const size_t _n)
+{
+    if (!project(_points, _n))
+        return 0.0;
+
+    if (convex())
+        return convex_radius();
+
+    return ear_radius();
+}
+
+//====================================================================================================================//
+bool IndicatorsInscribed::project(const Point* _points, const size_t _n)
+{
+    x_.clear();
+    y_.clear();
+
+    if (_n < 3)
+        return false;
+
+    // Newell normal and centroid, the polygon is counterclockwise in the (u, v) frame
+    Point normal(0, 0, 0);
+    Point centroid(0, 0, 0);
+    for (size_t i(0); i < _n; ++i)
+    {
+        const Point& cur = _points[i];
+        const Point& nxt = _points[(i+1) % _n];
+
+        normal[0] += (cur[1] - nxt[1]) * (cur[2] + nxt[2]);
+        normal[1] += (cur[2] - nxt[2]) * (cur[0] + nxt[0]);
+        normal[2] += (cur[0] - nxt[0]) * (cur[1] + nxt[1]);
+        centroid += cur;
+    }
+    centroid /= double(_n);
+
+    const double norm = normal.norm();
+    if (!(norm > std::numeric_limits<double>::min()))
+        return false;
+    normal /= norm;
+
+    Point axis(0, 0, 0);
+    const double ax = std::fabs(normal[0]), ay = std::fabs(normal[1]), az = std::fabs(normal[2]);
+    axis[(ax <= ay && ax <= az) ? 0 : (ay <= az ? 1 : 2)] = 1.0;
+
+    const Point u = (normal % axis).normalize();
+    const Point v = normal % u;
+
+    // drop repeated points, their edge has no direction
+    double scale(0);
+    for (size_t i(0); i < _n; ++i)
+    {
+        scale = std::max(scale, (_points[i] - centroid).norm());
+    }
+    const double eps = scale * 1e-12;
+
+    for (size_t i(0); i < _n; ++i)
+    {
+        const Point p = _points[i] - centroid;
+        const double px = p | u;
+        const double py = p | v;
+
+        if (!x_.empty() && std::hypot(px - x_.back(), py - y_.back()) <= eps)
+            continue;
+
+        x_.push_back(px);
+        y_.push_back(py);
+    }
+
+    while (x_.size() > 1 && std::hypot(x_.front() - x_.back(), y_.front() - y_.back()) <= eps)
+    {
+        x_.pop_back();
+        y_.pop_back();
+    }
+
+    return x_.size() >= 3;
+}
+
+bool IndicatorsInscribed::convex() const
+{
+    const size_t n = x_.size();
+
+    for (size_t i(0); i < n; ++i)
+    {
+        const size_t p = (i + n - 1) % n;
+        const size_t q = (i + 1) % n;
+
+        const double e0x = x_[i] - x_[p], e0y = y_[i] - y_[p];
+        const double e1x = x_[q] - x_[i], e1y = y_[q] - y_[i];
+
+        const double cross = e0x * e1y - e0y * e1x;
+        if (cross < -1e-12 * std::hypot(e0x, e0y) * std::hypot(e1x, e1y))
+            return false;
+    }
+
+    return true;
+}
+
+//====================================================================================================================//
+bool IndicatorsInscribed::concurrent(const Line& _a, const Line& _b, const Line& _c, double& _t)
+{
+    // n.x - t = d for the three lines, Cramer's rule on (x, y, t)
+    const double det = _a.nx * (_c.ny - _b.ny) - _a.ny * (_c.nx - _b.nx) - (_b.nx * _c.ny - _b.ny * _c.nx);
+    if (std::fabs(det) < 1e-14)
+        return false;
+
+    const double det_t = _a.nx * (_b.ny * _c.d - _c.ny * _b.d)
+                       - _a.ny * (_b.nx * _c.d - _c.nx * _b.d)
+                       + _a.d * (_b.nx * _c.ny - _b.ny * _c.nx);
+
+    _t = det_t / det;
+    return true;
+}
+
+bool IndicatorsInscribed::parallel(const Line& _a, const Line& _b)
+{
+    // same direction, opposite edges of a strip are not merged
+    return std::fabs(_a.nx * _b.ny - _a.ny * _b.nx) < 1e-12 && (_a.nx * _b.nx + _a.ny * _b.ny) > 0;
+}
+
+double IndicatorsInscribed::collapse(const size_t _i) const
+{
+    double t;
+    if (!concurrent(lines_[prev_[_i]], lines_[_i], lines_[next_[_i]], t))
+        return std::numeric_limits<double>::max();
+
+    return t;
+}
+
+double IndicatorsInscribed::convex_radius()
+{
+    const size_t n = x_.size();
+
+    // edge lines, consecutive collinear edges are merged
+    lines_.clear();
+    for (size_t i(0); i < n; ++i)
+    {
+        const size_t q = (i + 1) % n;
+        const double len = std::hypot(x_[q] - x_[i], y_[q] - y_[i]);
+
+        Line l;
+        l.nx = -(y_[q] - y_[i]) / len;
+        l.ny = (x_[q] - x_[i]) / len;
+        l.d = l.nx * x_[i] + l.ny * y_[i];
+
+        if (!lines_.empty() && parallel(lines_.back(), l))
+            continue;
+
+        lines_.push_back(l);
+    }
+
+    while (lines_.size() > 1 && parallel(lines_.back(), lines_.front()))
+    {
+        lines_.pop_back();
+    }
+
+    const size_t m = lines_.size();
+    if (m < 3)
+        return 0.0;
+
+    prev_.resize(m);
+    next_.resize(m);
+    collapse_.resize(m);
+    removed_.assign(m, 0);
+    heap_.clear();
+
+    for (size_t i(0); i < m; ++i)
+    {
+        prev_[i] = (i + m - 1) % m;
+        next_[i] = (i + 1) % m;
+    }
+
+    // min-heap of collapse times, entries are stale when they no longer match collapse_
+    const auto later = std::greater<std::pair<double, size_t>>();
+    for (size_t i(0); i < m; ++i)
+    {
+        collapse_[i] = collapse(i);
+        heap_.emplace_back(collapse_[i], i);
+    }
+    std::make_heap(heap_.begin(), heap_.end(), later);
+
+    size_t alive(m);
+    size_t last(0);
+    while (alive > 3 && !heap_.empty())
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), later);
+        const std::pair<double, size_t> top = heap_.back();
+        heap_.pop_back();
+
+        const size_t i = top.second;
+        if (removed_[i] || top.first != collapse_[i])
+            continue;
+
+        removed_[i] = 1;
+        alive--;
+
+        const size_t p = prev_[i];
+        const size_t q = next_[i];
+        next_[p] = q;
+        prev_[q] = p;
+        last = p;
+
+        collapse_[p] = collapse(p);
+        heap_.emplace_back(collapse_[p], p);
+        std::push_heap(heap_.begin(), heap_.end(), later);
+
+        collapse_[q] = collapse(q);
+        heap_.emplace_back(collapse_[q], q);
+        std::push_heap(heap_.begin(), heap_.end(), later);
+    }
+
+    const double t = collapse(last);
+    if (t == std::numeric_limits<double>::max())
+        return 0.0;
+
+    return std::max(0.0, t);
+}
+
+//====================================================================================================================//
+double IndicatorsInscribed::ear_radius()
+{
+    const size_t n = x_.size();
+
+    auto cross = [&](const size_t _a, const size_t _b, const size_t _c)
+    {
+        return (x_[_b] - x_[_a]) * (y_[_c] - y_[_a]) - (y_[_b] - y_[_a]) * (x_[_c] - x_[_a]);
+    };
+
+    auto incircle = [&](const size_t _a, const size_t _b, const size_t _c)
+    {
+        const double perimeter = std::hypot(x_[_b] - x_[_a], y_[_b] - y_[_a])
+                               + std::hypot(x_[_c] - x_[_b], y_[_c] - y_[_b])
+                               + std::hypot(x_[_a] - x_[_c], y_[_a] - y_[_c]);
+        if (!(perimeter > 0))
+            return 0.0;
+        return std::fabs(cross(_a, _b, _c)) / perimeter;
+    };
+
+    polygon_.resize(n);
+    for (size_t i(0); i < n; ++i)
+    {
+        polygon_[i] = i;
+    }
+
+    double r(0.0);
+    while (polygon_.size() > 3)
+    {
+        const size_t k = polygon_.size();
+        bool clipped(false);
+
+        for (size_t i(0); i < k && !clipped; ++i)
+        {
+            const size_t a = polygon_[(i + k - 1) % k];
+            const size_t b = polygon_[i];
+            const size_t c = polygon_[(i + 1) % k];
+
+            if (cross(a, b, c) <= 0)
+                continue;
+
+            bool ear(true);
+            for (size_t j(0); j < k && ear; ++j)
+            {
+                const size_t p = polygon_[j];
+                if (p == a || p == b || p == c)
+                    continue;
+
+                ear = !(cross(a, b, p) >= 0 && cross(b, c, p) >= 0 && cross(c, a, p) >= 0);
+            }
+
+            if (ear)
+            {
+                r = std::max(r, incircle(a, b, c));
+                polygon_.erase(polygon_.begin() + i);
+                clipped = true;
+            }
+        }
+
+        // self-intersecting or numerically degenerated
+        if (!clipped)
+            return r;
+    }
+
+    return std::max(r, incircle(polygon_[0], polygon_[1], polygon_[2]));
+}
@@ -0,0 +1,64 @@
+#ifndef INDICATORS_INSCRIBED_HH
+#define INDICATORS_INSCRIBED_HH
+
+#include <ACG/Math/VectorT.hh>
+
+#include <utility>
+#include <vector>
+
+// largest circle inscribed in a polygon face, computed in the best-fit (Newell) plane of the face
+//
+// convex polygons: the edges are offset inwards at unit speed and removed when they collapse, in order of
+// collapse time (straight skeleton), the last three lines meet at the center and the offset is the radius,
+// O(n log n) per face
+// non-convex polygons: the face is split by ear clipping and the largest incircle of the ears is returned,
+// a lower bound of the exact radius. every ear is searched from the first corner with an O(n) test per
+// candidate, O(n^3) per face in the worst case and O(n^2) when the ears are found early in the scan
+//
+// the buffers are kept between calls, one instance per thread
+class IndicatorsInscribed
+{
+public:
+    using Point = ACG::Vec3d;
+
+    double radius(const Point* _points, const size_t _n);
+
+private:
+    // unit inward normal, a point x is inside when n.x - d >= 0
+    struct Line
+    {
+        double nx;
+        double ny;
+        double d;
+    };
+
+    bool project(const Point* _points, const size_t _n);
+
+    bool convex() const;
+
+    double convex_radius();
+
+    double ear_radius();
+
+    // offset t at which the three lines, moved inwards by t, go through a common point
+    static bool concurrent(const Line& _a, const Line& _b, const Line& _c, double& _t);
+
+    static bool parallel(const Line& _a, const Line& _b);
+
+    double collapse(const size_t _i) const;
+
+private:
+    std::vector<double> x_;
+    std::vector<double> y_;
+
+    std::vector<Line> lines_;
+    std::vector<size_t> prev_;
+    std::vector<size_t> next_;
+    std::vector<double> collapse_;
+    std::vector<char> removed_;
+    std::vector<std::pair<double, size_t>> heap_;
+
+    std::vector<size_t> polygon_;
+};
+
+#endif // INDICATORS_INSCRIBED_HH
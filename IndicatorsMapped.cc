@@ -0,0 +1,98 @@
+#include "IndicatorsMapped.hh"
+
+#include <algorithm>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool IndicatorsMapped::open(const std::string& _path)
+{
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    // the mapping keeps the file open
+    CloseHandle(file);
+    if (!mapping)
+        return false;
+
+    data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(size.QuadPart);
+    handle_ = mapping;
+#else
+    const int file = ::open(_path.c_str(), O_RDONLY);
+    if (file < 0)
+        return false;
+
+    struct stat st;
+    void* data = MAP_FAILED;
+    if (fstat(file, &st) == 0 && st.st_size > 0)
+        data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, file, 0);
+
+    // the mapping keeps the file open
+    ::close(file);
+    if (data == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const char*>(data);
+    size_ = static_cast<size_t>(st.st_size);
+#endif
+
+    return true;
+}
+
+void IndicatorsMapped::close()
+{
+    if (!data_)
+        return;
+
+#if defined(_WIN32)
+    UnmapViewOfFile(data_);
+    CloseHandle(handle_);
+#else
+    munmap(const_cast<char*>(data_), size_);
+#endif
+
+    data_ = nullptr;
+    size_ = 0;
+    handle_ = nullptr;
+}
+
+void IndicatorsMapped::release(const size_t _offset, const size_t _size) const
+{
+    if (!data_ || _offset >= size_)
+        return;
+
+#if defined(_WIN32)
+    // the working set is trimmed by the system, unlocking only hints that the pages are not needed
+    VirtualUnlock(const_cast<char*>(data_) + _offset, std::min(_size, size_ - _offset));
+#else
+    // whole pages inside the range only
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t begin = (_offset + page - 1) / page * page;
+    const size_t end = std::min(size_, _offset + _size) / page * page;
+    if (begin < end)
+        madvise(const_cast<char*>(data_) + begin, end - begin, MADV_DONTNEED);
+#endif
+}
@@ -0,0 +1,41 @@
+#ifndef INDICATORS_MAPPED_HH
+#define INDICATORS_MAPPED_HH
+
+#include <cstddef>
+#include <string>
+
+// read only memory mapping of a whole file. the pages are loaded on first access and, being backed by the file,
+// can be dropped again by the system at any time, so a mapping larger than the memory only costs the pages in use
+class IndicatorsMapped
+{
+public:
+    IndicatorsMapped(): data_(nullptr), size_(0), handle_(nullptr) {}
+
+    ~IndicatorsMapped() { close(); }
+
+    IndicatorsMapped(const IndicatorsMapped&) = delete;
+    IndicatorsMapped& operator=(const IndicatorsMapped&) = delete;
+
+    // false when the file cannot be read, an empty file is not mapped
+    bool open(const std::string& _path);
+
+    void close();
+
+    bool is_open() const { return data_ != nullptr; }
+
+    const char* data() const { return data_; }
+
+    size_t size() const { return size_; }
+
+    // the pages of [_offset, _offset + _size) are not needed anymore, they are read again when accessed
+    void release(const size_t _offset, const size_t _size) const;
+
+private:
+    const char* data_;
+    size_t size_;
+
+    // file mapping object on windows
+    void* handle_;
+};
+
+#endif // INDICATORS_MAPPED_HH
@@ -4,9 +4,22 @@
 
 #include "IndicatorsTriangles.hh"
 #include "IndicatorsPolygons.hh"
+#include "IndicatorsTetrahedra.hh"
 
 using namespace indicatorsType;
 
+IndicatorsPlugin::~IndicatorsPlugin()
+{
+  if (running_)
+  {
+    for (auto& job: run_.jobs)
+    {
+      job.indicators->cancel();
+    }
+    worker_.join();
+  }
+}
+
 void IndicatorsPlugin::initializePlugin()
 {
   // Create the Toolbox Widget
@@ -24,100 +37,333 @@ void IndicatorsPlugin::initializePlugin()
   layout->addWidget(output_max_value_label_, 2, 1);
   layout->addWidget(output_avg_value_label_, 3, 1);
 
-  QPushButton* warpingButton                = new QPushButton("&Warping", toolBox);
-  QPushButton* aspectRatioButton            = new QPushButton("&Aspect ratio", toolBox);
-  QPushButton* skewnessButton               = new QPushButton("&Skewness", toolBox);
-  QPushButton* taperButton                  = new QPushButton("&Taper", toolBox);
-  QPushButton* interpolationQuatityButton   = new QPushButton("&Interpolation quality", toolBox);
-  QPushButton* meanRatioButton              = new QPushButton("&Mean ratio", toolBox);
-  QPushButton* shapeRegularityButton        = new QPushButton("&Shape regularity", toolBox);
-
-  layout->addWidget(warpingButton, 0, 0);
-  layout->addWidget(aspectRatioButton, 1, 0);
-  layout->addWidget(skewnessButton, 2, 0);
-  layout->addWidget(taperButton, 3, 0);
-  layout->addWidget(interpolationQuatityButton, 4, 0);
-  layout->addWidget(meanRatioButton, 5, 0);
-  layout->addWidget(shapeRegularityButton, 6, 0);
-
-  connect(warpingButton, SIGNAL(clicked()), this, SLOT(slot_calculate_warping()));
-  connect(aspectRatioButton, SIGNAL(clicked()), this, SLOT(slot_calculate_aspect_ratio()));
-  connect(skewnessButton, SIGNAL(clicked()), this, SLOT(slot_calculate_skewness()));
-  connect(taperButton, SIGNAL(clicked()), this, SLOT(slot_calculate_taper()));
-  connect(interpolationQuatityButton, SIGNAL(clicked()), this, SLOT(slot_calculate_interpolation_quality()));
-  connect(meanRatioButton, SIGNAL(clicked()), this, SLOT(slot_calculate_mean_ratio()));
-  connect(shapeRegularityButton, SIGNAL(clicked()), this, SLOT(slot_calculate_shape_regularity()));
+  // one button per registered indicator
+  int row(0);
+  for (const auto& entry: indicatorsRegistry::entries())
+  {
+    QPushButton* button = new QPushButton(entry.label, toolBox);
+    layout->addWidget(button, row++, 0);
+    calculate_buttons_.push_back(button);
+
+    const indicators i = entry.id;
+    connect(button, &QPushButton::clicked, this, [this, i]() { calculate({i}); });
+  }
+
+  QPushButton* allButton = new QPushButton("A&ll indicators", toolBox);
+  layout->addWidget(allButton, row++, 0);
+  calculate_buttons_.push_back(allButton);
+
+  QLabel* numThreadsLabel = new QLabel(tr("Threads"), toolBox);
+  num_threads_spin_ = new QSpinBox(toolBox);
+  num_threads_spin_->setRange(0, 256);
+  num_threads_spin_->setValue(0);
+  num_threads_spin_->setSpecialValueText(tr("All cores"));
+
+  layout->addWidget(numThreadsLabel, row, 0);
+  layout->addWidget(num_threads_spin_, row++, 1);
+
+  incremental_check_ = new QCheckBox(tr("Only recompute edited faces"), toolBox);
+  incremental_check_->setChecked(true);
+
+  layout->addWidget(incremental_check_, row++, 0, 1, 2);
+
+  QLabel* worstLabel = new QLabel(tr("Select worst"), toolBox);
+  worst_spin_ = new QSpinBox(toolBox);
+  worst_spin_->setRange(0, 100000000);
+  worst_spin_->setValue(0);
+  worst_spin_->setSpecialValueText(tr("Off"));
+
+  layout->addWidget(worstLabel, row, 0);
+  layout->addWidget(worst_spin_, row++, 1);
+
+  worst_threshold_check_ = new QCheckBox(tr("Worse than"), toolBox);
+  worst_threshold_spin_ = new QDoubleSpinBox(toolBox);
+  worst_threshold_spin_->setRange(0.0, 1e6);
+  worst_threshold_spin_->setDecimals(4);
+  worst_threshold_spin_->setSingleStep(0.05);
+  worst_threshold_spin_->setValue(0.2);
+  worst_threshold_spin_->setEnabled(false);
+
+  layout->addWidget(worst_threshold_check_, row, 0);
+  layout->addWidget(worst_threshold_spin_, row++, 1);
+
+  connect(worst_threshold_check_, SIGNAL(toggled(bool)), worst_threshold_spin_, SLOT(setEnabled(bool)));
+
+  progress_bar_ = new QProgressBar(toolBox);
+  progress_bar_->setRange(0, 100);
+  progress_bar_->setVisible(false);
+  cancel_button_ = new QPushButton(tr("&Cancel"), toolBox);
+  cancel_button_->setEnabled(false);
+
+  layout->addWidget(progress_bar_, row, 0);
+  layout->addWidget(cancel_button_, row++, 1);
+
+  QPushButton* exportButton = new QPushButton(tr("Export values"), toolBox);
+  QPushButton* loadButton = new QPushButton(tr("Load values"), toolBox);
+  calculate_buttons_.push_back(exportButton);
+  calculate_buttons_.push_back(loadButton);
+
+  layout->addWidget(exportButton, row, 0);
+  layout->addWidget(loadButton, row++, 1);
+
+  connect(exportButton, &QPushButton::clicked, this, [this, toolBox]()
+  {
+    const QString directory = QFileDialog::getExistingDirectory(toolBox, tr("Export the indicator values to"));
+    if (!directory.isEmpty())
+      slot_export_values(directory);
+  });
+
+  connect(loadButton, &QPushButton::clicked, this, [this, toolBox]()
+  {
+    const QString directory = QFileDialog::getExistingDirectory(toolBox, tr("Load the indicator values from"));
+    if (!directory.isEmpty())
+      slot_load_values(directory);
+  });
+
+  objects_table_ = new QTableWidget(0, 6, toolBox);
+  objects_table_->setHorizontalHeaderLabels({tr("Object"), tr("Faces"), tr("Indicator"), tr("Min"), tr("Max"), tr("Average")});
+  objects_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+  objects_table_->setVisible(false);
+
+  layout->addWidget(objects_table_, row, 0, 1, 2);
+
+  progress_timer_ = new QTimer(this);
+  progress_timer_->setInterval(100);
+
+  connect(allButton, SIGNAL(clicked()), this, SLOT(slot_calculate_all()));
+  connect(cancel_button_, SIGNAL(clicked()), this, SLOT(slot_cancel()));
+  connect(progress_timer_, SIGNAL(timeout()), this, SLOT(slot_progress()));
 
   emit addToolbox(tr("Quality indicators"), toolBox);
 }
 
 //====================================================================================================================//
+void IndicatorsPlugin::slotObjectUpdated(int _identifier, const UpdateType& _type)
+{
+  if (updating_)
+    return;
+
+  auto it = cache_.find(_identifier);
+  if (it == cache_.end())
+    return;
+
+  if (_type.contains(UPDATE_TOPOLOGY))
+    it->second.topology_revision++;
+  else if (_type.contains(UPDATE_GEOMETRY))
+    it->second.geometry_revision++;
+}
+
+void IndicatorsPlugin::objectDeleted(int _id)
+{
+  for (auto& job: run_.jobs)
+  {
+    if (running_ && job.object_id == _id)
+      stop();
+  }
+
+  cache_.erase(_id);
+}
+
+void IndicatorsPlugin::slotAllCleared()
+{
+  stop();
+  cache_.clear();
+}
+
+//====================================================================================================================//
+void IndicatorsPlugin::slot_calculate(QString _name)
+{
+  indicators i;
+  if (!from_s(_name.toStdString(), i))
+  {
+    emit log(LOGERR, tr("Unknown indicator %1.").arg(_name));
+    return;
+  }
+
+  calculate({i});
+}
+
+void IndicatorsPlugin::slot_calculate_all()
+{
+  calculate(all());
+}
+
 void IndicatorsPlugin::slot_calculate_warping()
 {
-  slot_calculate(WARPING);
+  calculate({WARPING});
 }
 
 void IndicatorsPlugin::slot_calculate_aspect_ratio()
 {
-  slot_calculate(ASPECTRATIO);
+  calculate({ASPECTRATIO});
 }
 
 void IndicatorsPlugin::slot_calculate_skewness()
 {
-  slot_calculate(SKEWNESS);
+  calculate({SKEWNESS});
 }
 
 void IndicatorsPlugin::slot_calculate_taper()
 {
-  slot_calculate(TAPER);
+  calculate({TAPER});
 }
 
 void IndicatorsPlugin::slot_calculate_interpolation_quality()
 {
-  slot_calculate(INTERPOLATIONQUALITY);
+  calculate({INTERPOLATIONQUALITY});
 }
 
 void IndicatorsPlugin::slot_calculate_mean_ratio()
 {
-  slot_calculate(MEANRATIO);
+  calculate({MEANRATIO});
 }
 
 void IndicatorsPlugin::slot_calculate_shape_regularity()
 {
-  slot_calculate(SHAPEREGULARITY);
+  calculate({SHAPEREGULARITY});
 }
 
-//====================================================================================================================//
-void IndicatorsPlugin::slot_calculate(indicators i)
+void IndicatorsPlugin::slot_export_values(QString _directory)
 {
-  QString type = tr("Undefined");
-  QString min_result = tr("Undefined");
-  QString max_result = tr("Undefined");
-  QString avg_result = tr("Undefined");
-  Indicators *indicat = nullptr;
+  if (running_)
+    return;
 
+  int exported(0);
   for (PluginFunctions::ObjectIterator o_it(PluginFunctions::TARGET_OBJECTS);
         o_it != PluginFunctions::objectsEnd(); ++o_it)
   {
-    if (o_it->dataType(DATA_TRIANGLE_MESH)) 
+    // only the values computed before, the edits since are taken into account by indicators_for
+    if (cache_.find(o_it->id()) == cache_.end())
+      continue;
+
+    Indicators* indicators = indicators_for(*o_it);
+    const QString path = QDir(_directory).filePath(o_it->name() + ".columns");
+
+    if (indicators && indicators->export_values(path.toStdString()))
+      exported++;
+    else
+      emit log(LOGWARN, tr("%1: no up to date values to export.").arg(o_it->name()));
+  }
+
+  emit log(LOGINFO, tr("Exported the values of %1 objects to %2.").arg(exported).arg(_directory));
+}
+
+void IndicatorsPlugin::slot_load_values(QString _directory)
+{
+  if (running_)
+    return;
+
+  int loaded(0);
+  for (PluginFunctions::ObjectIterator o_it(PluginFunctions::TARGET_OBJECTS);
+        o_it != PluginFunctions::objectsEnd(); ++o_it)
+  {
+    const QString path = QDir(_directory).filePath(o_it->name() + ".columns");
+    if (!QFileInfo::exists(path))
+      continue;
+
+    Indicators* indicators = indicators_for(*o_it);
+    if (!indicators)
+      continue;
+
+    configure(indicators);
+    indicators->cancel(false);
+
+    if (indicators->load_values(path.toStdString()))
+      loaded++;
+    else
+      emit log(LOGWARN, tr("%1: %2 is not a values file of this mesh.").arg(o_it->name()).arg(path));
+  }
+
+  // the next computation of the loaded indicators only returns their results
+  emit log(LOGINFO, tr("Loaded the values of %1 objects from %2.").arg(loaded).arg(_directory));
+}
+
+//====================================================================================================================//
+Indicators* IndicatorsPlugin::indicators_for(BaseObjectData* _object)
+{
+  Cache& cache = cache_[_object->id()];
+
+  if (!cache.indicators)
+  {
+    if (_object->dataType(DATA_TRIANGLE_MESH))
     {
-      TriMeshObject *tri_obj = PluginFunctions::triMeshObject(*o_it);
-      TriMesh *mesh = tri_obj->mesh();
+      TriMesh *mesh = PluginFunctions::triMeshObject(_object)->mesh();
 
       if (mesh)
-      {
-        indicat = new IndicatorsTriangles(*mesh);
-      }
-      emit log(LOGERR, "Triangle mesh not supported for warping.");
+        cache.indicators.reset(new IndicatorsTriangles(*mesh));
     }
-      else if (o_it->dataType(DATA_POLY_MESH))
+      else if (_object->dataType(DATA_POLY_MESH))
     {
-      PolyMesh *mesh = PluginFunctions::polyMesh(*o_it);
+      PolyMesh *mesh = PluginFunctions::polyMesh(_object);
 
       if (mesh)
-      {
-        indicat = new IndicatorsPolygons(*mesh);
-      }
+        cache.indicators.reset(new IndicatorsPolygons(*mesh));
+    }
+      else if (_object->dataType(DATA_TETRAHEDRAL_MESH))
+    {
+      TetrahedralMeshObject *tet_obj = PluginFunctions::tetrahedralMeshObject(_object);
+
+      if (tet_obj && tet_obj->mesh())
+        cache.indicators.reset(new IndicatorsTetrahedra(*tet_obj->mesh(), &tet_obj->colors(), &tet_obj->status()));
+    }
+
+    if (!cache.indicators)
+    {
+      cache_.erase(_object->id());
+      return nullptr;
+    }
+  }
+    else if (cache.topology_revision != cache.synced_topology_revision)
+  {
+    cache.indicators->invalidate_snapshot();
+  }
+    else if (cache.geometry_revision != cache.synced_geometry_revision)
+  {
+    cache.indicators->geometry_changed();
+  }
+
+  // unchanged meshes reuse the cached values, the evaluation only recolors the faces
+  cache.synced_topology_revision = cache.topology_revision;
+  cache.synced_geometry_revision = cache.geometry_revision;
+
+  return cache.indicators.get();
+}
+
+void IndicatorsPlugin::configure(Indicators* _indicators)
+{
+  _indicators->set_num_threads(num_threads_spin_->value());
+  _indicators->set_incremental(incremental_check_->isChecked());
+  _indicators->set_worst_faces(worst_spin_->value(), worst_threshold_check_->isChecked()
+    ? worst_threshold_spin_->value() : std::numeric_limits<double>::quiet_NaN());
+}
+
+void IndicatorsPlugin::calculate(const std::vector<indicators>& _indicators)
+{
+  if (running_)
+    return;
+
+  const bool warping = std::find(_indicators.begin(), _indicators.end(), WARPING) != _indicators.end();
+
+  run_.jobs.clear();
+  run_.requested = _indicators;
+  run_.start = std::chrono::steady_clock::now();
+  run_.seconds = 0;
+
+  for (PluginFunctions::ObjectIterator o_it(PluginFunctions::TARGET_OBJECTS);
+        o_it != PluginFunctions::objectsEnd(); ++o_it)
+  {
+    if (o_it->dataType(DATA_TRIANGLE_MESH) || o_it->dataType(DATA_POLY_MESH) || o_it->dataType(DATA_TETRAHEDRAL_MESH))
+    {
+      if (warping && o_it->dataType(DATA_TRIANGLE_MESH))
+        emit log(LOGERR, "Triangle mesh not supported for warping.");
+
+      Job job;
+      job.object_id = o_it->id();
+      job.name = o_it->name();
+      job.indicators = indicators_for(*o_it);
+
+      if (job.indicators)
+        run_.jobs.push_back(job);
     }
       else
     {
@@ -125,76 +371,328 @@ void IndicatorsPlugin::slot_calculate(indicators i)
     }
   }
 
-  if (indicat != nullptr)
+  if (run_.jobs.empty())
   {
-    type = QString::fromStdString(as_s(i));
-    Indicators::Result r;
-    r.min = -1;
+    show_results({}, {});
+    objects_table_->setVisible(false);
+    return;
+  }
+
+  // the objects are evaluated side by side and share the configured threads, as the jobs of IndicatorsCli, so the
+  // small ones finish while the largest keeps its share of the cores busy, without cores x cores threads
+  const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+  const unsigned int budget = num_threads_spin_->value() > 0 ? num_threads_spin_->value() : cores;
+  const size_t workers = std::min<size_t>(run_.jobs.size(), budget);
+  const unsigned int threads = std::max<unsigned int>(1, budget / workers);
+
+  for (auto& job: run_.jobs)
+  {
+    configure(job.indicators);
+    job.indicators->set_num_threads(threads);
+    // colors are applied in slot_finished, on this thread
+    job.indicators->set_coloring(false);
+    job.indicators->cancel(false);
+  }
+
+  set_running(true);
 
-    switch (i)
+  worker_ = std::thread([this, workers]()
+  {
+    const size_t n_jobs = run_.jobs.size();
+
+    std::atomic<size_t> next(0);
+    auto worker = [&]()
+    {
+      for (size_t j = next++; j < n_jobs; j = next++)
+      {
+        Job& job = run_.jobs[j];
+        job.results = job.indicators->compute_all(run_.requested);
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t t(1); t < workers; ++t)
     {
-      case WARPING:
-        r = indicat->warping();
-        break;
-      case ASPECTRATIO:
-        r = indicat->aspect_ratio();
-        break;
-      case SKEWNESS:
-        r = indicat->skewness();
-        break;
-      case TAPER:
-        r = indicat->taper();
-        break;
-      case INTERPOLATIONQUALITY:
-        r = indicat->interpolation_quality();
-        break;
-      case MEANRATIO:
-        r = indicat->mean_ratio();
-        break;
-      case SHAPEREGULARITY:
-        r = indicat->shape_regularity();
-        break;
+      threads.emplace_back(worker);
     }
 
-    if (r.min >= 0)
+    worker();
+
+    for (auto& t: threads)
     {
-      min_result = tr("Min value: %1").arg(r.min);
-      max_result = tr("Max value: %1").arg(r.max);
-      avg_result = tr("Average: %1").arg(r.average);
+      t.join();
+    }
 
-      for (PluginFunctions::ObjectIterator o_it(PluginFunctions::TARGET_OBJECTS);
-          o_it != PluginFunctions::objectsEnd(); ++o_it)
-      {
-        if (o_it->dataType(DATA_TRIANGLE_MESH)) 
-        {
-          TriMeshObject *tri_obj = PluginFunctions::triMeshObject(*o_it);
-          TriMesh *mesh = tri_obj->mesh();
-
-          if (mesh)
-          {
-            //set draw mode
-            tri_obj->meshNode()->drawMode(ACG::SceneGraph::DrawModes::FACES
-              | ACG::SceneGraph::DrawModes::SOLID_FACES_COLORED);
-
-            emit updatedObject(tri_obj->id(), UPDATE_ALL);
-          }
-        }
-          else if (o_it->dataType(DATA_POLY_MESH))
-        {
-          //set draw mode
-          //o_it->meshNode()->drawMode(ACG::SceneGraph::DrawModes::FACES
-          //    | ACG::SceneGraph::DrawModes::SOLID_FACES_COLORED);
-
-          emit updatedObject(o_it->id(), UPDATE_ALL);
-        }
-      }
+    QMetaObject::invokeMethod(this, "slot_finished", Qt::QueuedConnection);
+  });
+}
+
+void IndicatorsPlugin::slot_finished()
+{
+  if (!running_)
+    return;
+
+  worker_.join();
+  set_running(false);
+
+  const bool cancelled = std::any_of(run_.jobs.begin(), run_.jobs.end(),
+    [](const Job& _job) { return _job.indicators->cancelled(); });
+
+  if (cancelled)
+  {
+    emit log(LOGWARN, tr("Indicator computation cancelled."));
+    show_results({}, {});
+    objects_table_->setVisible(false);
+    output_type_label_->setText(tr("Cancelled"));
+    return;
+  }
+
+  // one result over all objects per indicator
+  std::vector<Indicators::Result> results;
+  for (size_t k(0); k < run_.requested.size(); ++k)
+  {
+    std::vector<Indicators::Result> per_object;
+    for (const auto& job: run_.jobs)
+    {
+      per_object.push_back(job.results[k]);
     }
+    results.push_back(Indicators::merge(per_object));
+  }
+
+  // all objects are colored on the combined range of the first defined indicator
+  int colored(-1);
+  for (size_t k(0); k < results.size(); ++k)
+  {
+    if (results[k].min < 0)
+      continue;
 
-    delete indicat;
+    if (colored < 0)
+      colored = k;
+
+    if (results.size() > 1)
+    {
+      QString name = QString::fromStdString(as_s(run_.requested[k]));
+      emit log(LOGINFO, tr("%1: min %2, max %3, average %4, 1% quantile %5, median %6").arg(name).arg(results[k].min)
+        .arg(results[k].max).arg(results[k].average).arg(results[k].distribution.quantile(0.01))
+        .arg(results[k].distribution.quantile(0.5)));
+    }
+  }
+
+  show_results(run_.requested, results);
+  show_objects(run_);
+
+  if (colored < 0)
+  {
+    log_profile();
+    return;
+  }
+
+  updating_ = true;
+
+  for (auto& job: run_.jobs)
+  {
+    BaseObjectData* object = nullptr;
+    if (job.results[colored].min < 0 || !PluginFunctions::getObject(job.object_id, object))
+      continue;
+
+    job.indicators->apply_colors(run_.requested[colored], results[colored]);
+
+    UpdateType update = UPDATE_COLOR;
+    if (worst_spin_->value() > 0)
+    {
+      // the worst faces of the colored indicator, per object
+      job.indicators->select_worst(job.results[colored]);
+      update |= UPDATE_SELECTION;
+
+      const std::vector<IndicatorsWorst::Face> worst = job.results[colored].worst.faces();
+      emit log(LOGINFO, tr("%1: selected %2 worst faces of %3%4").arg(job.name).arg(worst.size())
+        .arg(QString::fromStdString(as_s(run_.requested[colored])))
+        .arg(worst.empty() ? QString() : tr(", the worst %1 on face %2").arg(worst.front().value).arg(worst.front().face)));
+    }
+
+    if (object->dataType(DATA_TRIANGLE_MESH)) 
+    {
+      TriMeshObject *tri_obj = PluginFunctions::triMeshObject(object);
+
+      //set draw mode
+      tri_obj->meshNode()->drawMode(ACG::SceneGraph::DrawModes::FACES
+        | ACG::SceneGraph::DrawModes::SOLID_FACES_COLORED);
+    }
+      else if (object->dataType(DATA_POLY_MESH))
+    {
+      //set draw mode
+      //o_it->meshNode()->drawMode(ACG::SceneGraph::DrawModes::FACES
+      //    | ACG::SceneGraph::DrawModes::SOLID_FACES_COLORED);
+    }
+      else if (object->dataType(DATA_TETRAHEDRAL_MESH))
+    {
+      TetrahedralMeshObject *tet_obj = PluginFunctions::tetrahedralMeshObject(object);
+
+      //set draw mode
+      tet_obj->meshNode()->drawMode(tet_obj->meshNode()->drawModes().cellsColoredPerCell);
+    }
+
+    // only the color and selection buffers are rebuilt
+    const IndicatorsProfile::Timer timer(job.indicators->profile(), IndicatorsProfile::REDRAW);
+    emit updatedObject(object->id(), update);
+  }
+
+  updating_ = false;
+
+  log_profile();
+}
+
+void IndicatorsPlugin::log_profile()
+{
+  const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - run_.start;
+  run_.seconds = seconds.count();
+
+  for (auto& job: run_.jobs)
+  {
+    job.profile = job.indicators->profile().report();
+    emit log(LOGINFO, tr("%1: %2").arg(job.name).arg(QString::fromStdString(job.profile.text())));
+  }
+
+  emit log(LOGINFO, tr("Computed %1 objects in %2 ms.").arg(run_.jobs.size()).arg(1e3 * run_.seconds));
+}
+
+QVariantList IndicatorsPlugin::slot_profile()
+{
+  QVariantList profile;
+  for (const auto& job: run_.jobs)
+  {
+    QVariantMap object;
+    object["object"] = job.name;
+    for (const auto& entry: job.profile.entries())
+    {
+      object[QString::fromStdString(entry.first)] = entry.second;
+    }
+    profile << object;
+  }
+
+  return profile;
+}
+
+void IndicatorsPlugin::slot_cancel()
+{
+  if (running_)
+  {
+    for (auto& job: run_.jobs)
+    {
+      job.indicators->cancel();
+    }
+    cancel_button_->setEnabled(false);
+  }
+}
+
+void IndicatorsPlugin::slot_progress()
+{
+  if (!running_)
+    return;
+
+  double progress(0.0);
+  for (const auto& job: run_.jobs)
+  {
+    progress += job.indicators->progress();
+  }
+
+  progress_bar_->setValue(static_cast<int>(100 * progress / run_.jobs.size()));
+}
+
+void IndicatorsPlugin::stop()
+{
+  if (!running_)
+    return;
+
+  // the queued slot_finished finds nothing to do
+  for (auto& job: run_.jobs)
+  {
+    job.indicators->cancel();
+  }
+  worker_.join();
+  set_running(false);
+}
+
+void IndicatorsPlugin::set_running(const bool _running)
+{
+  running_ = _running;
+
+  for (auto button: calculate_buttons_)
+  {
+    button->setEnabled(!_running);
+  }
+
+  cancel_button_->setEnabled(_running);
+  progress_bar_->setValue(0);
+  progress_bar_->setVisible(_running);
+
+  if (_running)
+    progress_timer_->start();
+  else
+    progress_timer_->stop();
+}
+
+void IndicatorsPlugin::show_results(const std::vector<indicators>& _indicators, const std::vector<Indicators::Result>& _results)
+{
+  QString type = tr("Undefined");
+  QString min_result = tr("Undefined");
+  QString max_result = tr("Undefined");
+  QString avg_result = tr("Undefined");
+
+  QStringList types, mins, maxs, avgs;
+  for (size_t k(0); k < _results.size(); ++k)
+  {
+    const Indicators::Result& r = _results[k];
+    if (r.min < 0)
+      continue;
+
+    types << QString::fromStdString(as_s(_indicators[k]));
+    mins << tr("Min value: %1").arg(r.min);
+    maxs << tr("Max value: %1").arg(r.max);
+    avgs << tr("Average: %1").arg(r.average);
+  }
+
+  if (_indicators.size() == 1)
+    type = QString::fromStdString(as_s(_indicators.front()));
+  else if (!types.isEmpty())
+    type = types.join("\n");
+
+  if (!types.isEmpty())
+  {
+    min_result = mins.join("\n");
+    max_result = maxs.join("\n");
+    avg_result = avgs.join("\n");
   }
 
   output_type_label_->setText(type);
   output_min_value_label_->setText(min_result);
   output_max_value_label_->setText(max_result);
   output_avg_value_label_->setText(avg_result);
-}
\ No newline at end of file
+}
+
+void IndicatorsPlugin::show_objects(const Run& _run)
+{
+  objects_table_->setRowCount(0);
+
+  for (const auto& job: _run.jobs)
+  {
+    for (size_t k(0); k < job.results.size(); ++k)
+    {
+      const Indicators::Result& r = job.results[k];
+      if (r.min < 0)
+        continue;
+
+      const int row = objects_table_->rowCount();
+      objects_table_->insertRow(row);
+      objects_table_->setItem(row, 0, new QTableWidgetItem(job.name));
+      objects_table_->setItem(row, 1, new QTableWidgetItem(QString::number(r.nb)));
+      objects_table_->setItem(row, 2, new QTableWidgetItem(QString::fromStdString(as_s(_run.requested[k]))));
+      objects_table_->setItem(row, 3, new QTableWidgetItem(QString::number(r.min)));
+      objects_table_->setItem(row, 4, new QTableWidgetItem(QString::number(r.max)));
+      objects_table_->setItem(row, 5, new QTableWidgetItem(QString::number(r.average)));
+    }
+  }
+
+  objects_table_->resizeColumnsToContents();
+  objects_table_->setVisible(objects_table_->rowCount() > 0);
+}
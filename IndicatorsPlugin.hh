@@ -11,11 +11,28 @@
 #include <QLabel>
 #include <QGridLayout>
 #include <QSpinBox>
+#include <QDoubleSpinBox>
+#include <QCheckBox>
+#include <QProgressBar>
+#include <QTableWidget>
+#include <QTimer>
+#include <QStringList>
+#include <QVariant>
+#include <QFileDialog>
+#include <QDir>
+#include <QFileInfo>
 
 #include <ACG/Utils/HaltonColors.hh>
 #include <ACG/Scenegraph/LineNode.hh>
 
+#include "Indicators.hh"
 #include "IndicatorsType.hh"
+#include "IndicatorsRegistry.hh"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <thread>
 
 class IndicatorsPlugin : public QObject, BaseInterface, ToolboxInterface, LoggingInterface, LoadSaveInterface
 {
@@ -43,9 +60,12 @@ class IndicatorsPlugin : public QObject, BaseInterface, ToolboxInterface, Loggin
 
   public:
     IndicatorsPlugin():
-    output_type_label_(0), output_min_value_label_(0), output_max_value_label_(0), output_avg_value_label_(0)
+    output_type_label_(0), output_min_value_label_(0), output_max_value_label_(0), output_avg_value_label_(0),
+    objects_table_(0), num_threads_spin_(0), incremental_check_(0), worst_spin_(0), worst_threshold_check_(0),
+    worst_threshold_spin_(0), progress_bar_(0), cancel_button_(0), progress_timer_(0),
+    updating_(false), running_(false)
     {}
-    ~IndicatorsPlugin() {}
+    ~IndicatorsPlugin();
 
     // BaseInterface
     QString name() { return (QString("IndicatorsPlugin")); };
@@ -57,27 +77,136 @@ class IndicatorsPlugin : public QObject, BaseInterface, ToolboxInterface, Loggin
     QLabel* output_max_value_label_;
     QLabel* output_avg_value_label_;
 
+    // per object results of the last computation
+    QTableWidget* objects_table_;
+
+    QSpinBox* num_threads_spin_;
+    QCheckBox* incremental_check_;
+
+    // number of worst faces selected after a computation, 0 for none, optionally only those worse than the threshold
+    QSpinBox* worst_spin_;
+    QCheckBox* worst_threshold_check_;
+    QDoubleSpinBox* worst_threshold_spin_;
+
+    QProgressBar* progress_bar_;
+    QPushButton* cancel_button_;
+    QTimer* progress_timer_;
+
+    // disabled while a computation runs
+    std::vector<QPushButton*> calculate_buttons_;
+
+    // indicators of one object, kept between evaluations with their per-face values, and the revisions of the mesh
+    // counted from the update notifications against the ones the values were computed for
+    struct Cache
+    {
+      std::unique_ptr<Indicators> indicators;
+
+      unsigned int geometry_revision = 0;
+      unsigned int topology_revision = 0;
+
+      unsigned int synced_geometry_revision = 0;
+      unsigned int synced_topology_revision = 0;
+    };
+
+    std::map<int, Cache> cache_;
+
+    // set while our own color updates are emitted
+    bool updating_;
+
+    // one target object of a computation
+    struct Job
+    {
+      int object_id = -1;
+      QString name;
+      Indicators* indicators = nullptr;
+      std::vector<Indicators::Result> results;
+
+      // profile of the evaluation, with the coloring and the redraw of the object
+      IndicatorsProfile::Report profile;
+    };
+
+    // computation running on worker_, its results are applied by slot_finished on the GUI thread
+    struct Run
+    {
+      std::vector<Job> jobs;
+      std::vector<indicatorsType::indicators> requested;
+
+      // from the request to the redraw of the last object
+      std::chrono::steady_clock::time_point start;
+      double seconds = 0;
+    };
+
+    Run run_;
+    std::thread worker_;
+    bool running_;
+
+    Indicators* indicators_for(BaseObjectData*);
+
+    // threads, incremental evaluation and worst faces from the toolbox
+    void configure(Indicators*);
+
+    // starts the computation in the background
+    void calculate(const std::vector<indicatorsType::indicators>&);
+
+    // cancels and waits for the running computation, its results are dropped
+    void stop();
+
+    void set_running(const bool);
+
+    void show_results(const std::vector<indicatorsType::indicators>&, const std::vector<Indicators::Result>&);
+
+    void show_objects(const Run&);
+
+    // keeps the profile of every object of the finished run_ and logs it
+    void log_profile();
+
    private slots:
     // BaseInterface
     void initializePlugin();
 
-    void slot_calculate(indicatorsType::indicators);
+    void slotObjectUpdated(int _identifier, const UpdateType& _type);
+
+    void objectDeleted(int _id);
+
+    void slotAllCleared();
+
+    void slot_finished();
+
+    void slot_cancel();
+
+    void slot_progress();
 
    public slots:
+    // indicator by name, as indicatorsType::from_s, e.g. "aspect_ratio"
+    void slot_calculate(QString _name);
+
+    void slot_calculate_all();
+
+    // one slot per indicator, as before the buttons were made from the registry, for the existing scripts
     void slot_calculate_warping();
-    
+
     void slot_calculate_aspect_ratio();
-    
+
     void slot_calculate_skewness();
-    
+
     void slot_calculate_taper();
-    
+
     void slot_calculate_interpolation_quality();
-    
+
     void slot_calculate_mean_ratio();
-    
+
     void slot_calculate_shape_regularity();
 
+    // writes the values of the target objects to <object name>.columns in _directory, see Indicators::export_values
+    void slot_export_values(QString _directory);
+
+    // reads them back, the objects whose mesh changed since are skipped
+    void slot_load_values(QString _directory);
+
+    // profile of the last computation, one map per object with its "object" name, "faces", the times of the
+    // phases in milliseconds, e.g. "kernels_ms", and the counters, see IndicatorsProfile::Report::entries
+    QVariantList slot_profile();
+
     QString version() { return QString("1.0"); };
 };
 
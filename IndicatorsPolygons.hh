@@ -9,66 +9,150 @@
 class IndicatorsPolygons : public Indicators
 {
 public:
-    IndicatorsPolygons(PolyMesh& _mesh):
-    Indicators(), mesh_(_mesh), rd_(), mt_(rd_())
+    IndicatorsPolygons(PolyMesh& _mesh, const unsigned int _seed = std::minstd_rand::default_seed):
+    Indicators(), mesh_(_mesh), seed_(_seed)
     {
-        mesh_.add_property(face_warping_, "Warping");
-        mesh_.add_property(face_aspect_ratio_, "Aspect ratio");
-        mesh_.add_property(face_skewness_, "Skewness");
-        mesh_.add_property(face_taper_, "Taper");
-        mesh_.add_property(face_interpolation_quality_, "Interpolation quality");
-        mesh_.add_property(face_mean_ratio_, "Mean ratio");
-        mesh_.add_property(face_shape_regularity_, "Shape Regularity");
+        add_properties<indicatorsRegistry::Polygon>(mesh_);
     }
 
     virtual ~IndicatorsPolygons()
     {
-        mesh_.remove_property(face_warping_);
-        mesh_.remove_property(face_aspect_ratio_);
-        mesh_.remove_property(face_skewness_);
-        mesh_.remove_property(face_taper_);
-        mesh_.remove_property(face_interpolation_quality_);
-        mesh_.remove_property(face_mean_ratio_);
-        mesh_.remove_property(face_shape_regularity_);
+        remove_properties(mesh_);
     }
 
 public:
-    virtual Result warping() override;
+    virtual std::vector<Result> compute_all(const std::vector<indicatorsType::indicators>& _indicators) override
+    {
+        return compute_list(indicatorsRegistry::All(), _indicators);
+    }
 
-    virtual Result aspect_ratio() override;
+    virtual void select_worst(const Result& _result) override { select_faces(mesh_, _result.worst); }
 
-    virtual Result skewness() override;
+    virtual bool export_values(const std::string& _path) override
+    {
+        update_snapshot();
+        return export_columns(mesh_, _path);
+    }
 
-    virtual Result taper() override;
+    virtual bool load_values(const std::string& _path) override
+    {
+        update_snapshot();
+        return load_columns(mesh_, _path);
+    }
 
-    virtual Result interpolation_quality() override;
+    // the indicators Is only, in a loop instantiated for them, e.g. compute<indicatorsRegistry::Warping>()
+    template<class... Is>
+    std::vector<Result> compute()
+    {
+        return compute_list(indicatorsRegistry::List<Is...>(), indicatorsRegistry::ids(indicatorsRegistry::List<Is...>()));
+    }
 
-    virtual Result mean_ratio() override;
+    virtual double value(const indicatorsType::indicators& _i, const size_t _f) const override
+    {
+        return face_values(mesh_, _i)[_f];
+    }
 
-    virtual Result shape_regularity() override;
+    // seed of the point shuffling in the enclosing sphere computation
+    void set_seed(const unsigned int _seed) { seed_ = _seed; }
 
 private:
-    struct Sphere
+    // fused traversal of the indicators of the list, the requested ones not in it are undefined
+    template<class... Is>
+    std::vector<Result> compute_list(indicatorsRegistry::List<Is...>, const std::vector<indicatorsType::indicators>&);
+
+    void get_polygon(const size_t, std::vector<Point>&) const;
+
+    // face source of evaluate_polygons(), the faces of a chunk read from the snapshot
+    struct Source
     {
-        Point center;
-        double radius;
-    };
+        const IndicatorsPolygons& indicators;
+        const Faces& faces;
 
-    bool inside(const Sphere&, const Point&);
+        size_t face(const size_t _i) const { return faces[_i]; }
 
-    Sphere from_boundary(const std::vector<Point>&);
+        bool polygon(const size_t _i, std::vector<Point>& _points) const
+        {
+            indicators.get_polygon(faces[_i], _points);
+            return true;
+        }
+    };
 
-    Sphere radius(std::vector<Point>, std::vector<Point>, bool = true);
+    // positions of the faces in _faces, those of valence 3 to 6 grouped by valence and the larger ones last
+    void by_valence(const Faces& _faces, std::vector<unsigned int>& _order) const;
 
-    double radius(const PolyMesh::FaceHandle&, bool = true);
+    void update_snapshot();
 
-    virtual void color_coding(const OpenMesh::FPropHandleT<double>&, const double, const double) override;
+    virtual void color_coding(const indicatorsType::indicators&, const double, const double) override;
 
 private:
     PolyMesh& mesh_;
 
-    std::random_device rd_;
-    std::mt19937 mt_;
+    unsigned int seed_;
 };
 
+//====================================================================================================================//
+template<class... Is>
+std::vector<Indicators::Result> IndicatorsPolygons::compute_list(indicatorsRegistry::List<Is...> _list,
+    const std::vector<indicatorsType::indicators>& _indicators)
+{
+    // a single traversal, every requested indicator is evaluated on a face gathered once. the faces of a chunk
+    // are visited grouped by valence, which only reorders them: the indicators still switch on the arity of each
+    // face, the branch is just taken in runs. they are reduced in face order afterwards so that the sums do not
+    // depend on the grouping. the buffers of the loop are kept in the workspace of the thread
+    const IndicatorsProfile::Run run(profile_);
+
+    bool defined[indicatorsType::n_indicators];
+    indicatorsRegistry::defined<indicatorsRegistry::Polygon>(_list, defined);
+
+    const Request request = this->request(_indicators, defined);
+    const std::vector<indicatorsType::indicators>& active = request.active;
+
+    if (active.empty())
+        return results(_indicators, request, {});
+
+    {
+        const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::GEOMETRY);
+        update_snapshot();
+    }
+
+    std::vector<FaceValues<PolyMesh>> face_values;
+    for (auto i: active)
+    {
+        face_values.push_back(this->face_values(mesh_, i));
+    }
+
+    auto reductions = evaluate(mesh_, active, [&](const Faces& _faces, Reduction* _reductions)
+    {
+        thread_local indicatorsRegistry::Workspace workspace;
+
+        const size_t n_values = active.size();
+        std::vector<double>& stored = workspace.stored;
+        stored.resize(_faces.n * n_values);
+
+        by_valence(_faces, workspace.order);
+
+        const Source source = {*this, _faces};
+        evaluate_polygons(_list, source, 0, _faces.n, workspace.order.data(), seed_, workspace, request,
+            [&](const size_t _i, const size_t _k, const double _value)
+        {
+            stored[_i * n_values + _k] = face_values[_k].set(_faces[_i], _value);
+        });
+
+        if (_reductions)
+        {
+            for (size_t i(0); i < _faces.n * n_values; ++i)
+            {
+                _reductions[i % n_values].add(_faces[i / n_values], stored[i]);
+            }
+        }
+    });
+
+    std::vector<Result> results = this->results(_indicators, request, reductions);
+
+    const Reduction& first = reductions.front();
+    color(active.front(), first.min, first.max);
+
+    return results;
+}
+
 #endif // INDICATORS_POLYGONS_HH
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "IndicatorsProfile.hh"
+
+#include <cstdio>
+
+namespace
+{
+    thread_local size_t allocations = 0;
+
+    std::atomic<bool> counting(false);
+
+    std::string format(const char* _format, const double _value)
+    {
+        char s[64];
+        std::snprintf(s, sizeof(s), _format, _value);
+        return s;
+    }
+}
+
+std::string IndicatorsProfile::as_s(const phase& _phase)
+{
+    static const char* names[n_phases] = {"geometry", "kernels", "worst", "columns", "color", "select", "redraw"};
+    return names[_phase];
+}
+
+std::string IndicatorsProfile::as_s(const counter& _counter)
+{
+    static const char* names[n_counters] = {"faces", "allocations", "welzl_calls", "welzl_depth"};
+    return names[_counter];
+}
+
+//====================================================================================================================//
+size_t IndicatorsProfile::thread_allocations()
+{
+    return allocations;
+}
+
+void IndicatorsProfile::count_allocation()
+{
+    allocations++;
+}
+
+void IndicatorsProfile::set_counting_allocations(const bool _counting)
+{
+    counting = _counting;
+}
+
+bool IndicatorsProfile::counting_allocations()
+{
+    return counting;
+}
+
+//====================================================================================================================//
+void IndicatorsProfile::start()
+{
+    start_ = std::chrono::steady_clock::now();
+    start_allocations_ = thread_allocations();
+
+    seconds_ = 0;
+    for (size_t p(0); p < n_phases; ++p)
+    {
+        phases_[p] = 0;
+    }
+
+    for (size_t c(0); c < n_counters; ++c)
+    {
+        counters_[c] = 0;
+    }
+}
+
+void IndicatorsProfile::stop()
+{
+    const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start_;
+    seconds_ = seconds.count();
+
+    // the workers of the loops add their own
+    add(ALLOCATIONS, thread_allocations() - start_allocations_);
+}
+
+void IndicatorsProfile::raise(const counter& _counter, const size_t _n)
+{
+    size_t current = counters_[_counter].load(std::memory_order_relaxed);
+    while (current < _n && !counters_[_counter].compare_exchange_weak(current, _n, std::memory_order_relaxed))
+    {
+    }
+}
+
+IndicatorsProfile::Report IndicatorsProfile::report() const
+{
+    Report r;
+    r.seconds = seconds_;
+    for (size_t p(0); p < n_phases; ++p)
+    {
+        r.phases[p] = phases_[p];
+    }
+
+    for (size_t c(0); c < n_counters; ++c)
+    {
+        r.counters[c] = counters_[c];
+    }
+
+    r.allocations_counted = counting_allocations();
+    return r;
+}
+
+//====================================================================================================================//
+double IndicatorsProfile::Report::faces_per_second() const
+{
+    return phases[KERNELS] > 0 ? counters[FACES] / phases[KERNELS] : 0.0;
+}
+
+std::vector<std::pair<std::string, double>> IndicatorsProfile::Report::entries() const
+{
+    std::vector<std::pair<std::string, double>> e;
+    e.emplace_back("total_ms", 1e3 * seconds);
+
+    for (size_t p(0); p < n_phases; ++p)
+    {
+        e.emplace_back(as_s(static_cast<phase>(p)) + "_ms", 1e3 * phases[p]);
+    }
+
+    for (size_t c(0); c < n_counters; ++c)
+    {
+        if (c != ALLOCATIONS || allocations_counted)
+            e.emplace_back(as_s(static_cast<counter>(c)), double(counters[c]));
+    }
+
+    e.emplace_back("faces_per_second", faces_per_second());
+    return e;
+}
+
+std::string IndicatorsProfile::Report::text() const
+{
+    std::string t = format("%.3g ms", 1e3 * seconds) + ", " + std::to_string(counters[FACES]) + " faces";
+    if (faces_per_second() > 0)
+        t += format(" at %.3g faces/s", faces_per_second());
+
+    for (size_t p(0); p < n_phases; ++p)
+    {
+        if (phases[p] > 0)
+            t += ", " + as_s(static_cast<phase>(p)) + format(" %.3g ms", 1e3 * phases[p]);
+    }
+
+    if (allocations_counted)
+        t += ", " + std::to_string(counters[ALLOCATIONS]) + " allocations";
+
+    if (counters[WELZL_CALLS])
+        t += ", Welzl depth " + std::to_string(counters[WELZL_DEPTH]) + " in " + std::to_string(counters[WELZL_CALLS]) + " calls";
+
+    return t;
+}
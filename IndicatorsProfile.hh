@@ -0,0 +1,136 @@
+#ifndef INDICATORS_PROFILE_HH
+#define INDICATORS_PROFILE_HH
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// wall time per phase and counters of the last evaluation of an Indicators object. a phase reads the clock twice
+// and the counters are added once per chunk of faces, so the profile is always on.
+//
+// the heap allocations of the threads of the evaluation are only counted in the executables that count them, see
+// cli/IndicatorsAllocations.cc, a plugin shares the allocator of its host
+class IndicatorsProfile
+{
+public:
+    enum phase {GEOMETRY, KERNELS, WORST, COLUMNS, COLOR, SELECT, REDRAW};
+
+    static const size_t n_phases = REDRAW + 1;
+
+    enum counter {FACES, ALLOCATIONS, WELZL_CALLS, WELZL_DEPTH};
+
+    static const size_t n_counters = WELZL_DEPTH + 1;
+
+    // e.g. "kernels", "welzl_depth"
+    static std::string as_s(const phase&);
+    static std::string as_s(const counter&);
+
+    // profile of one evaluation as plain values. the phases timed after it, e.g. the coloring by apply_colors() or
+    // the redraw of the plugin, are added to it
+    struct Report
+    {
+        // wall time of the evaluation, the phases are parts of it except those timed after it
+        double seconds = 0;
+
+        double phases[n_phases] = {};
+        size_t counters[n_counters] = {};
+
+        bool allocations_counted = false;
+
+        // faces evaluated per second of the kernels phase
+        double faces_per_second() const;
+
+        // name and value of every measure, the times in milliseconds with an "_ms" suffix, e.g. {"kernels_ms", 9.8},
+        // the allocations only when they are counted
+        std::vector<std::pair<std::string, double>> entries() const;
+
+        // one line for a log, the phases that took no time are left out
+        std::string text() const;
+    };
+
+    IndicatorsProfile() { start(); }
+
+    IndicatorsProfile(const IndicatorsProfile&) = delete;
+    IndicatorsProfile& operator=(const IndicatorsProfile&) = delete;
+
+    // clears the profile for a new evaluation
+    void start();
+
+    // takes the wall time of the evaluation and the allocations of the calling thread
+    void stop();
+
+    // from the thread of the evaluation only
+    void add(const phase& _phase, const double _seconds) { phases_[_phase] += _seconds; }
+
+    // from any thread
+    void add(const counter& _counter, const size_t _n) { counters_[_counter].fetch_add(_n, std::memory_order_relaxed); }
+
+    // keeps the largest value
+    void raise(const counter& _counter, const size_t _n);
+
+    Report report() const;
+
+    // adds the time spent in its scope to a phase
+    class Timer
+    {
+    public:
+        Timer(IndicatorsProfile& _profile, const phase& _phase):
+        profile_(_profile), phase_(_phase), start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        ~Timer() { stop(); }
+
+        // ends the phase before the scope does
+        void stop()
+        {
+            if (stopped_)
+                return;
+
+            const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start_;
+            profile_.add(phase_, seconds.count());
+            stopped_ = true;
+        }
+
+    private:
+        IndicatorsProfile& profile_;
+        phase phase_;
+        std::chrono::steady_clock::time_point start_;
+        bool stopped_ = false;
+    };
+
+    // an evaluation, started and stopped with its scope
+    class Run
+    {
+    public:
+        Run(IndicatorsProfile& _profile): profile_(_profile) { profile_.start(); }
+
+        ~Run() { profile_.stop(); }
+
+    private:
+        IndicatorsProfile& profile_;
+    };
+
+    // heap allocations made so far by the calling thread, 0 when they are not counted
+    static size_t thread_allocations();
+
+    // called by the counting operator new of cli/IndicatorsAllocations.cc
+    static void count_allocation();
+
+    static void set_counting_allocations(const bool _counting);
+
+    static bool counting_allocations();
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    size_t start_allocations_;
+
+    double seconds_;
+    double phases_[n_phases];
+    std::atomic<size_t> counters_[n_counters];
+};
+
+#endif // INDICATORS_PROFILE_HH
@@ -0,0 +1,677 @@
+#ifndef INDICATORS_REGISTRY_HH
+#define INDICATORS_REGISTRY_HH
+
+#include "IndicatorsType.hh"
+#include "IndicatorsSimd.hh"
+#include "IndicatorsInscribed.hh"
+#include "IndicatorsEnclosing.hh"
+
+#include <ACG/Math/VectorT.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// compile time list of the indicators. each one is a functor with one overload per kind of element it is
+// defined on, taking the geometry of the element:
+//
+//   Triangle     the corners of a face of a triangle mesh
+//   Polygon      the corners of a face of a polygon mesh in order, and the per thread helpers of the radii
+//   Tetrahedron  the corners of a cell, with the edges, volume and edge lengths shared by the indicators
+//
+// the engines expand a list into one fused loop per kind of element, the indicators without an overload for it
+// are dropped at compile time and undefined on that kind. the triangle indicators of the batched kernels of
+// IndicatorsSimd name their output in `batched` instead of an overload. lower values are worse unless the
+// functor declares `higher_is_worse`, its face properties are named after it unless it declares `property`.
+//
+// a new indicator is a value of indicatorsType::indicators, a functor below and its place in All
+namespace indicatorsRegistry
+{
+    using Point = ACG::Vec3d;
+
+    //================================================================================================================//
+    struct Triangle
+    {
+        Point v0;
+        Point v1;
+        Point v2;
+    };
+
+    // fan of a polygon from the average of its corners, in the best-fit (Newell) plane of the face
+    struct Decomposition
+    {
+        void compute(const Point* _p, const size_t _n)
+        {
+            center = Point(0, 0, 0);
+            for (size_t i(0); i < _n; ++i)
+            {
+                center += _p[i];
+            }
+            center /= double(_n);
+
+            // twice the vector areas of the fan triangles sum up to the Newell normal
+            Point newell(0, 0, 0);
+            for (size_t i(0); i < _n; ++i)
+            {
+                newell += (_p[i] - center) % (_p[(i+1) % _n] - center);
+            }
+
+            const double length = newell.norm();
+            normal = length > std::numeric_limits<double>::min() ? newell / length : Point(0, 0, 0);
+            area = 0.5 * length;
+
+            min_fan_area = std::numeric_limits<double>::max();
+            max_fan_area = -std::numeric_limits<double>::max();
+            sqr_sum = 0.0;
+            log_product = 0.0;
+
+            for (size_t i(0); i < _n; ++i)
+            {
+                const Point& a = _p[i];
+                const Point& b = _p[(i+1) % _n];
+
+                // signed, negative when the fan triangle is flipped in a non-convex face
+                const double fan_area = 0.5 * (((a - center) % (b - center)) | normal);
+                min_fan_area = std::min(min_fan_area, fan_area);
+                max_fan_area = std::max(max_fan_area, fan_area);
+
+                const double sqr_l = (b - a).sqrnorm();
+                sqr_sum += sqr_l;
+                log_product += std::log(sqr_l);
+            }
+
+            n = _n;
+        }
+
+        // of the squared edge lengths, 0 when an edge is degenerated
+        double geometric_mean() const { return std::exp(log_product / n); }
+
+        size_t n;
+
+        Point center;
+        Point normal;
+
+        // of the face projected on its plane
+        double area;
+
+        // signed areas of the fan triangles (center, p_i, p_i+1)
+        double min_fan_area;
+        double max_fan_area;
+
+        // sum and sum of the logarithms of the squared edge lengths
+        double sqr_sum;
+        double log_product;
+    };
+
+    // scratch of the polygon indicators, one per thread
+    struct Workspace
+    {
+        IndicatorsInscribed inscribed;
+        IndicatorsEnclosing enclosing;
+
+        // corner normals of the faces past the fixed arity kernels
+        std::vector<Point> normals;
+
+        // decomposition of the current face, cleared by the engine before each face
+        Decomposition decomposition;
+        bool decomposed = false;
+
+        // seeded per face by the engine, a face gets the same shuffle whichever pass evaluates it
+        std::minstd_rand rng;
+
+        // corners of the current face, and visit order and values of the faces of the current chunk
+        std::vector<Point> points;
+        std::vector<unsigned int> order;
+        std::vector<double> stored;
+    };
+
+    struct Polygon
+    {
+        const Point* points;
+        size_t n;
+        Workspace* workspace;
+
+        // computed by the first indicator that needs it and shared by the other ones
+        const Decomposition& decomposition() const
+        {
+            if (!workspace->decomposed)
+            {
+                workspace->decomposition.compute(points, n);
+                workspace->decomposed = true;
+            }
+            return workspace->decomposition;
+        }
+    };
+
+    // area over sum of the squared edge lengths of the equilateral triangle relative to the one of the regular
+    // n-gon, sqrt(3) tan(pi / n). the polygon indicators are scaled by it so that a regular polygon scores as the
+    // equilateral triangle and a triangle face as on a triangle mesh
+    inline double regular_scale(const size_t _n)
+    {
+        return std::sqrt(3.0) * std::tan(M_PI / _n);
+    }
+
+    // edge e of a tetrahedron as (first, second) vertex, the two other vertices of the cell are opposite to it
+    inline int tetrahedron_edge(const size_t _e, const size_t _k)
+    {
+        static const int edges[6][4] = {{0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 2, 0, 3}, {1, 3, 2, 0}, {2, 3, 0, 1}};
+        return edges[_e][_k];
+    }
+
+    struct Tetrahedron
+    {
+        explicit Tetrahedron(const Point* _v):
+        v{_v[0], _v[1], _v[2], _v[3]}, a(_v[1] - _v[0]), b(_v[2] - _v[0]), d(_v[3] - _v[0]), sqr_sum(0.0), product(1.0)
+        {
+            for (size_t e(0); e < 6; ++e)
+            {
+                const double sqr_l = (v[tetrahedron_edge(e, 1)] - v[tetrahedron_edge(e, 0)]).sqrnorm();
+                sqr_sum += sqr_l;
+                product *= sqr_l;
+            }
+
+            det = std::abs(a | (b % d));
+            volume = det / 6.0;
+        }
+
+        Point v[4];
+
+        // edges from v[0]
+        Point a;
+        Point b;
+        Point d;
+
+        // sum and product of the squared edge lengths
+        double sqr_sum;
+        double product;
+
+        // 6 times the volume
+        double det;
+        double volume;
+    };
+
+    // angle between two directions by its cosine and sine, from the dot and the cross product without acos.
+    // the angle is 0 when one of them is degenerated
+    struct Angle
+    {
+        double cos;
+        double sin;
+    };
+
+    inline Angle angle(const Point& _d0, const Point& _d1)
+    {
+        const double denorm = _d0.norm() * _d1.norm();
+
+        if (denorm > std::numeric_limits<double>::min())
+            return {std::min(1.0, std::max(-1.0, (_d0 | _d1) / denorm)), (_d0 % _d1).norm() / denorm};
+
+        return {1.0, 0.0};
+    }
+
+    // smallest and largest of the angles added, compared through their cotangents cos/sin, cross multiplied,
+    // which still tell apart angles too small or too close to pi for their cosines to differ
+    struct AngleRange
+    {
+        Angle smallest = {1.0, 0.0};
+        Angle largest = {1.0, 0.0};
+        bool empty = true;
+
+        void add(const Angle& _a)
+        {
+            if (empty || smaller(_a, smallest))
+                smallest = _a;
+            if (empty || smaller(largest, _a))
+                largest = _a;
+            empty = false;
+        }
+
+        // the cosines decide between angles of sine 0
+        static bool smaller(const Angle& _a, const Angle& _b)
+        {
+            const double a = _a.cos * _b.sin;
+            const double b = _b.cos * _a.sin;
+            return a != b ? a > b : _a.cos > _b.cos;
+        }
+
+        // sine of the smallest over sine of the largest angle. a flat largest angle has sine 0 where sin(acos(-1))
+        // was about 1e-16, the ratio is 0 then, and undefined as before when every angle is 0
+        double sine_ratio() const
+        {
+            return largest.cos < 0 && !(largest.sin > 0) ? 0.0 : smallest.sin / largest.sin;
+        }
+    };
+
+    //================================================================================================================//
+    struct Warping
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::WARPING;
+        static const char* name() { return "Warping"; }
+        static const char* label() { return "&Warping"; }
+        static constexpr bool higher_is_worse = true;
+
+        // based on equ. 16 from paper, 1 - min(n_i . n_j)^3 over the normals at the corners of non adjacent edges
+        double operator()(const Polygon& _p) const
+        {
+            switch (_p.n)
+            {
+                case 4:     return fixed<4>(_p.points);
+                case 5:     return fixed<5>(_p.points);
+                case 6:     return fixed<6>(_p.points);
+                default:    break;
+            }
+
+            // triangles have no pair of non adjacent edges and are planar
+            if (_p.n <= 3)
+                return 0.0;
+
+            std::vector<Point>& normals = _p.workspace->normals;
+            normals.resize(_p.n);
+            corner_normals(_p.points, _p.n, normals.data());
+
+            return 1.0 - min_curvature(normals.data(), _p.n);
+        }
+
+    private:
+        // normal between edge i and edge i+1
+        static void corner_normals(const Point* _p, const size_t _n, Point* _normals)
+        {
+            for (size_t i(0); i < _n; ++i)
+            {
+                const Point edge = _p[(i+1) % _n] - _p[i];
+                const Point next = _p[(i+2) % _n] - _p[(i+1) % _n];
+                _normals[i] = (-edge % next).normalize();
+            }
+        }
+
+        static double curvature(const Point& _a, const Point& _b)
+        {
+            const double product = _a | _b;
+            return product * product * product;
+        }
+
+        // the pairs i < j of edges that are not adjacent, starting from (0, 2)
+        static double min_curvature(const Point* _normals, const size_t _n)
+        {
+            double m = curvature(_normals[0], _normals[2]);
+            for (size_t i(0); i < _n; ++i)
+            {
+                for (size_t j(i+2); j < _n; ++j)
+                {
+                    if ((j+1) % _n != i)
+                        m = std::min(m, curvature(_normals[i], _normals[j]));
+                }
+            }
+            return m;
+        }
+
+        // stack storage, the loops have constant bounds and are unrolled
+        template<size_t N>
+        static double fixed(const Point* _p)
+        {
+            Point normals[N];
+            corner_normals(_p, N, normals);
+            return 1.0 - min_curvature(normals, N);
+        }
+    };
+
+    struct AspectRatio
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::ASPECTRATIO;
+        static const char* name() { return "Aspect ratio"; }
+        static const char* label() { return "&Aspect ratio"; }
+
+        static constexpr double* indicatorsSimd::Values::* batched = &indicatorsSimd::Values::aspect_ratio;
+
+        // based on equ. 6 from paper
+        double operator()(const Polygon& _p) const
+        {
+            const double inradius = _p.workspace->inscribed.radius(_p.points, _p.n);
+            const double ccradius = _p.workspace->enclosing.radius(_p.points, _p.n, _p.workspace->rng);
+
+            return ccradius > std::numeric_limits<double>::min() ? inradius / ccradius : 0.0;
+        }
+
+        // inradius 3V / total face area over circumradius, 3 r / R
+        double operator()(const Tetrahedron& _t) const
+        {
+            const Point* v = _t.v;
+            const double area = ((v[1] - v[0]) % (v[2] - v[0])).norm() + ((v[1] - v[0]) % (v[3] - v[0])).norm()
+                + ((v[2] - v[0]) % (v[3] - v[0])).norm() + ((v[2] - v[1]) % (v[3] - v[1])).norm();
+            const double circumradius = (_t.a.sqrnorm() * (_t.b % _t.d) + _t.b.sqrnorm() * (_t.d % _t.a)
+                + _t.d.sqrnorm() * (_t.a % _t.b)).norm();
+
+            if (area > std::numeric_limits<double>::min() && circumradius > std::numeric_limits<double>::min())
+            {
+                // r = 6V / area with the doubled areas above, R = |...| / 12V
+                const double inradius = _t.det / area;
+                return 3.0 * inradius * 2.0 * _t.det / circumradius;
+            }
+
+            return 0.0;
+        }
+    };
+
+    struct Skewness
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::SKEWNESS;
+        static const char* name() { return "Skewness"; }
+        static const char* label() { return "&Skewness"; }
+
+        // based on equ. 7 from paper. by the law of sines the smallest and the largest angle are opposite the
+        // shortest and the longest edge, and the ratio of their sines is the one of the edge lengths
+        double operator()(const Triangle& _t) const
+        {
+            const Point e0 = _t.v1 - _t.v0;
+            const Point e1 = _t.v2 - _t.v1;
+            const Point e2 = _t.v0 - _t.v2;
+
+            if ((e0 % e2).sqrnorm() > 0)
+            {
+                const double sqr_e0 = e0.sqrnorm(), sqr_e1 = e1.sqrnorm(), sqr_e2 = e2.sqrnorm();
+                return std::sqrt(std::min(sqr_e0, std::min(sqr_e1, sqr_e2)) / std::max(sqr_e0, std::max(sqr_e1, sqr_e2)));
+            }
+
+            // no area, the corners decide between a flat angle and angles that are all 0
+            AngleRange angles;
+            angles.add(angle(_t.v1 - _t.v0, _t.v2 - _t.v0));
+            angles.add(angle(_t.v0 - _t.v1, _t.v2 - _t.v1));
+            angles.add(angle(_t.v0 - _t.v2, _t.v1 - _t.v2));
+
+            return angles.sine_ratio();
+        }
+
+        double operator()(const Polygon& _p) const
+        {
+            AngleRange angles;
+
+            // angle at every corner, between its previous and its next vertex
+            for (size_t i(0); i < _p.n; ++i)
+            {
+                const Point& node = _p.points[i];
+                angles.add(angle(_p.points[(i + _p.n - 1) % _p.n] - node, _p.points[(i+1) % _p.n] - node));
+            }
+
+            return angles.sine_ratio();
+        }
+
+        // sine of the smallest over sine of the largest dihedral angle
+        double operator()(const Tetrahedron& _t) const
+        {
+            const Point* v = _t.v;
+            AngleRange dihedrals;
+            for (size_t e(0); e < 6; ++e)
+            {
+                const Point& p0 = v[tetrahedron_edge(e, 0)];
+                Point axis = v[tetrahedron_edge(e, 1)] - p0;
+                const double sqr_axis = axis.sqrnorm();
+                if (sqr_axis <= std::numeric_limits<double>::min())
+                {
+                    dihedrals.add({1.0, 0.0});
+                    continue;
+                }
+
+                const Point u = v[tetrahedron_edge(e, 2)] - p0;
+                const Point w = v[tetrahedron_edge(e, 3)] - p0;
+                dihedrals.add(angle(u - axis * ((u | axis) / sqr_axis), w - axis * ((w | axis) / sqr_axis)));
+            }
+
+            const double sinMax(dihedrals.largest.sin);
+            return sinMax > std::numeric_limits<double>::min() ? dihedrals.smallest.sin / sinMax : 0.0;
+        }
+    };
+
+    struct Taper
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::TAPER;
+        static const char* name() { return "Taper"; }
+        static const char* label() { return "&Taper"; }
+
+        // smallest over largest area of the fan triangles, 1 for the regular polygons and every triangle, 0 once a
+        // fan triangle is flipped
+        double operator()(const Polygon& _p) const
+        {
+            const Decomposition& d = _p.decomposition();
+            return d.max_fan_area > std::numeric_limits<double>::min() ? std::max(0.0, d.min_fan_area / d.max_fan_area) : 0.0;
+        }
+    };
+
+    struct InterpolationQuality
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::INTERPOLATIONQUALITY;
+        static const char* name() { return "Interpolation quality"; }
+        static const char* label() { return "&Interpolation quality"; }
+
+        // based on equ. 9 from paper
+        static constexpr double* indicatorsSimd::Values::* batched = &indicatorsSimd::Values::interpolation_quality;
+
+        // area over the geometric mean of the squared edge lengths, A / (l1^2 ... ln^2)^(1/n)
+        double operator()(const Polygon& _p) const
+        {
+            const Decomposition& d = _p.decomposition();
+            const double mean = d.geometric_mean();
+            return mean > std::numeric_limits<double>::min() ? regular_scale(_p.n) / _p.n * d.area / mean : 0.0;
+        }
+
+        // volume over the square root of the product of the 6 edge lengths, 6 sqrt(2) V / prod(l)^(1/2)
+        double operator()(const Tetrahedron& _t) const
+        {
+            return _t.product > std::numeric_limits<double>::min()
+                ? 6.0 * std::sqrt(2.0) * _t.volume / std::pow(_t.product, 0.25) : 0.0;
+        }
+    };
+
+    struct MeanRatio
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::MEANRATIO;
+        static const char* name() { return "Mean ratio"; }
+        static const char* label() { return "&Mean ratio"; }
+
+        // based on equ. 11 from paper
+        static constexpr double* indicatorsSimd::Values::* batched = &indicatorsSimd::Values::mean_ratio;
+
+        // geometric over arithmetic mean of the squared edge lengths, n (l1^2 ... ln^2)^(1/n) / sum(l^2)
+        double operator()(const Polygon& _p) const
+        {
+            const Decomposition& d = _p.decomposition();
+            return d.sqr_sum > std::numeric_limits<double>::min() ? _p.n * d.geometric_mean() / d.sqr_sum : 0.0;
+        }
+
+        // 12 (3V)^(2/3) / sum(l^2)
+        double operator()(const Tetrahedron& _t) const
+        {
+            return _t.sqr_sum > std::numeric_limits<double>::min()
+                ? 12.0 * std::cbrt(9.0 * _t.volume * _t.volume) / _t.sqr_sum : 0.0;
+        }
+    };
+
+    struct ShapeRegularity
+    {
+        static constexpr indicatorsType::indicators id = indicatorsType::SHAPEREGULARITY;
+        static const char* name() { return "Shape regularity"; }
+        static const char* label() { return "&Shape regularity"; }
+
+        // the name its face properties had before the registry, kept for the scripts reading them
+        static const char* property() { return "Shape Regularity"; }
+
+        // based on equ. 14 from paper
+        static constexpr double* indicatorsSimd::Values::* batched = &indicatorsSimd::Values::shape_regularity;
+
+        // area over the sum of the squared edge lengths
+        double operator()(const Polygon& _p) const
+        {
+            const Decomposition& d = _p.decomposition();
+            return d.sqr_sum > std::numeric_limits<double>::min() ? regular_scale(_p.n) * d.area / d.sqr_sum : 0.0;
+        }
+
+        // volume over the cube of the root mean square edge length, 6 sqrt(2) V / l_rms^3
+        double operator()(const Tetrahedron& _t) const
+        {
+            return _t.sqr_sum > std::numeric_limits<double>::min()
+                ? 6.0 * std::sqrt(2.0) * _t.volume / std::pow(_t.sqr_sum / 6.0, 1.5) : 0.0;
+        }
+    };
+
+    //================================================================================================================//
+    template<class... Is>
+    struct List
+    {
+        static constexpr size_t size = sizeof...(Is);
+    };
+
+    // every indicator, in the order of indicatorsType::indicators
+    using All = List<Warping, AspectRatio, Skewness, Taper, InterpolationQuality, MeanRatio, ShapeRegularity>;
+
+    static_assert(All::size == indicatorsType::n_indicators, "an indicator is missing from the registry");
+
+    // I has an overload for Element
+    template<class I, class Element, class = void>
+    struct defined_on : std::false_type {};
+
+    template<class I, class Element>
+    struct defined_on<I, Element, decltype(void(std::declval<const I&>()(std::declval<const Element&>())))> : std::true_type {};
+
+    // I is evaluated by the batched triangle kernels
+    template<class I, class = void>
+    struct batched : std::false_type {};
+
+    template<class I>
+    struct batched<I, decltype(void(I::batched))> : std::true_type {};
+
+    // the worst values of I are the highest, when it declares so by a static higher_is_worse, otherwise the lowest
+    template<class I, class = void>
+    struct higher_is_worse : std::false_type {};
+
+    template<class I>
+    struct higher_is_worse<I, decltype(void(I::higher_is_worse))> : std::integral_constant<bool, I::higher_is_worse> {};
+
+    // name of the face and cell properties of I, its name unless it declares a static property()
+    template<class I, class = void>
+    struct property_name
+    {
+        static const char* get() { return I::name(); }
+    };
+
+    template<class I>
+    struct property_name<I, decltype(void(I::property()))>
+    {
+        static const char* get() { return I::property(); }
+    };
+
+    // I is evaluated on Element, by its overload or on triangles by the batched kernels
+    template<class I, class Element>
+    struct evaluated_on : defined_on<I, Element> {};
+
+    template<class I>
+    struct evaluated_on<I, Triangle> : std::integral_constant<bool, defined_on<I, Triangle>::value || batched<I>::value> {};
+
+    namespace detail
+    {
+        template<class I, class Element>
+        inline typename std::enable_if<defined_on<I, Element>::value>::type
+        apply(const Element& _e, const int* _slots, double* _values)
+        {
+            const int slot = _slots[I::id];
+            if (slot >= 0)
+                _values[slot] = I()(_e);
+        }
+
+        template<class I, class Element>
+        inline typename std::enable_if<!defined_on<I, Element>::value>::type
+        apply(const Element&, const int*, double*)
+        {
+        }
+
+        template<class I>
+        inline typename std::enable_if<batched<I>::value, double**>::type output(indicatorsSimd::Values& _values)
+        {
+            return &(_values.*I::batched);
+        }
+
+        template<class I>
+        inline typename std::enable_if<!batched<I>::value, double**>::type output(indicatorsSimd::Values&)
+        {
+            return nullptr;
+        }
+    }
+
+    // evaluates on _e the indicators of the list that have an overload for it, indicator id is written to
+    // _values[_slots[id]] and skipped when its slot is negative. the calls are expanded and inlined at compile time
+    template<class Element, class... Is>
+    inline void evaluate(List<Is...>, const Element& _e, const int* _slots, double* _values)
+    {
+        const int expand[] = {0, (detail::apply<Is>(_e, _slots, _values), 0)...};
+        (void)expand;
+    }
+
+    // _defined[id] is set when indicator id is in the list and evaluated on Element
+    template<class Element, class... Is>
+    inline void defined(List<Is...>, bool* _defined)
+    {
+        std::fill(_defined, _defined + indicatorsType::n_indicators, false);
+        const int expand[] = {0, (_defined[Is::id] = evaluated_on<Is, Element>::value, 0)...};
+        (void)expand;
+    }
+
+    // _outputs[id] is the member of _values receiving indicator id from the batched kernels, null when the list
+    // has no batched indicator id
+    template<class... Is>
+    inline void batched_outputs(List<Is...>, indicatorsSimd::Values& _values, double** _outputs[])
+    {
+        std::fill(_outputs, _outputs + indicatorsType::n_indicators, nullptr);
+        const int expand[] = {0, (_outputs[Is::id] = detail::output<Is>(_values), 0)...};
+        (void)expand;
+    }
+
+    template<class... Is>
+    inline std::vector<indicatorsType::indicators> ids(List<Is...>)
+    {
+        return {Is::id...};
+    }
+
+    //================================================================================================================//
+    // what the engines and the plugin know about an indicator at runtime
+    struct Entry
+    {
+        indicatorsType::indicators id;
+
+        const char* name;
+
+        // of its button
+        const char* label;
+
+        // of its face and cell properties
+        const char* property;
+
+        bool triangles;
+        bool polygons;
+        bool tetrahedra;
+
+        // its worst faces have the highest values
+        bool higher_is_worse;
+    };
+
+    template<class... Is>
+    inline std::vector<Entry> entries(List<Is...>)
+    {
+        return {Entry{Is::id, Is::name(), Is::label(), property_name<Is>::get(), evaluated_on<Is, Triangle>::value,
+            evaluated_on<Is, Polygon>::value, evaluated_on<Is, Tetrahedron>::value, higher_is_worse<Is>::value}...};
+    }
+
+    // entries of All, indexed by indicator
+    inline const std::vector<Entry>& entries()
+    {
+        static const std::vector<Entry> all = entries(All());
+        return all;
+    }
+
+    inline const Entry& entry(const indicatorsType::indicators& _i)
+    {
+        return entries()[_i];
+    }
+}
+
+#endif // INDICATORS_REGISTRY_HH
@@ -0,0 +1,133 @@
+#include "IndicatorsSimd.hh"
+
+#include <ACG/Geometry/Algorithms.hh>
+
+#include <cmath>
+#include <limits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define INDICATORS_SIMD_X86
+#endif
+
+indicatorsSimd::isa indicatorsSimd::detect()
+{
+#if defined(INDICATORS_SIMD_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    const int n_ids = info[0];
+
+    __cpuidex(info, 1, 0);
+    const bool osxsave = info[2] & (1 << 27);
+    const bool avx = info[2] & (1 << 28);
+    const unsigned long long xcr0 = osxsave ? _xgetbv(0) : 0;
+
+    bool avx2(false), avx512(false);
+    if (n_ids >= 7)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = avx && (info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6;
+        avx512 = (info[1] & (1 << 16)) && (xcr0 & 0xe6) == 0xe6;
+    }
+
+    if (avx512)
+        return AVX512;
+    if (avx2)
+        return AVX2;
+    return SSE2;
+#elif defined(INDICATORS_SIMD_X86) && defined(__GNUC__)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
+        return AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return AVX2;
+    return SSE2;
+#else
+    return SCALAR;
+#endif
+}
+
+indicatorsSimd::Kernel indicatorsSimd::kernel(const isa& i)
+{
+    switch (i)
+    {
+        case AVX512:    return triangles_avx512;
+        case AVX2:      return triangles_avx2;
+        case SSE2:      return triangles_sse2;
+        case SCALAR:    return triangles_scalar;
+    }
+    return triangles_scalar;
+}
+
+std::string indicatorsSimd::as_s(const isa& i)
+{
+    switch(i)
+    {
+        case SCALAR:    return "Scalar"; break;
+        case SSE2:      return "SSE2"; break;
+        case AVX2:      return "AVX2"; break;
+        case AVX512:    return "AVX-512"; break;
+    }
+    return "";
+}
+
+//====================================================================================================================//
+void indicatorsSimd::triangles_scalar(const Triangles& _t, const Values& _out)
+{
+    const bool cached = _t.sqr_e[0] && _t.sqr_e[1] && _t.sqr_e[2];
+
+    for (size_t i(0); i < _t.n; ++i)
+    {
+        ACG::Vec3d v0(_t.c[0][i], _t.c[1][i], _t.c[2][i]);
+        ACG::Vec3d v1(_t.c[3][i], _t.c[4][i], _t.c[5][i]);
+        ACG::Vec3d v2(_t.c[6][i], _t.c[7][i], _t.c[8][i]);
+
+        double sqr_e1 = cached ? _t.sqr_e[0][i] : (v0 - v1).sqrnorm();
+        double sqr_e2 = cached ? _t.sqr_e[1][i] : (v1 - v2).sqrnorm();
+        double sqr_e3 = cached ? _t.sqr_e[2][i] : (v2 - v0).sqrnorm();
+        double area = ACG::Geometry::triangleArea(v0, v1, v2);
+
+        double e1(0.0), e2(0.0), e3(0.0);
+        if (_out.aspect_ratio || _out.interpolation_quality)
+        {
+            e1 = _t.e[0] ? _t.e[0][i] : std::sqrt(sqr_e1);
+            e2 = _t.e[1] ? _t.e[1][i] : std::sqrt(sqr_e2);
+            e3 = _t.e[2] ? _t.e[2][i] : std::sqrt(sqr_e3);
+        }
+
+        if (_out.aspect_ratio)
+        {
+            // based on equ. 6 from paper
+            double semi_perimeter = (e1 + e2 + e3) / 2.0;
+            double inradius = area / semi_perimeter;
+            double circumradius = ACG::Geometry::circumRadius(v0, v1, v2);
+
+            double ar(0.0);
+            if(circumradius > std::numeric_limits<double>::min())
+            {
+                ar = inradius / circumradius;
+            }
+            _out.aspect_ratio[i] = ar;
+        }
+        if (_out.interpolation_quality)
+        {
+            // based on equ. 9 from paper
+            _out.interpolation_quality[i] = area / pow(e1 * e2 * e3, 2. / 3.);
+        }
+        if (_out.mean_ratio)
+        {
+            // based on equ. 11 from paper
+            _out.mean_ratio[i] = 3 * std::cbrt(sqr_e1*sqr_e2*sqr_e3) / (sqr_e1 + sqr_e2 + sqr_e3);
+        }
+        if (_out.shape_regularity)
+        {
+            // based on equ. 14 from paper
+            _out.shape_regularity[i] = 3 * area / (sqr_e1 + sqr_e2 + sqr_e3);
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef INDICATORS_SIMD_HH
+#define INDICATORS_SIMD_HH
+
+#include <cstddef>
+#include <string>
+
+// batched triangle kernels for aspect ratio, interpolation quality, mean ratio and shape regularity,
+// with one implementation per instruction set picked at runtime
+//
+// the vector kernels agree with the scalar one to within 4 ulp for aspect ratio and shape regularity, 8 ulp
+// for mean ratio and 16 ulp for interpolation quality with coordinates in [1e-4, 1e4]: cbrt is evaluated by
+// Newton iterations, and (e1 e2 e3)^(2/3) as cbrt(e1^2 e2^2 e3^2) where the scalar pow() loses about
+// |ln(e1 e2 e3)| ulp to the rounded exponent
+namespace indicatorsSimd
+{
+    enum isa {SCALAR, SSE2, AVX2, AVX512};
+
+    // coordinate arrays v0x, v0y, v0z, v1x, ..., v2z of n triangles, padded to a multiple of padding.
+    // sqr_e and e optionally hold the squared lengths and lengths of the edges v0v1, v1v2, v2v0, e.g. from the
+    // edge cache of the snapshot, they must be the bits the kernel would compute. nullptr recomputes them
+    struct Triangles
+    {
+        const double* c[9];
+        size_t n;
+
+        const double* sqr_e[3] = {nullptr, nullptr, nullptr};
+        const double* e[3] = {nullptr, nullptr, nullptr};
+    };
+
+    // one output array per indicator, nullptr when not requested, padded as the input
+    struct Values
+    {
+        double* aspect_ratio;
+        double* interpolation_quality;
+        double* mean_ratio;
+        double* shape_regularity;
+    };
+
+    static const size_t padding = 8;
+
+    typedef void (*Kernel)(const Triangles&, const Values&);
+
+    // widest instruction set supported by the compiler and the cpu
+    isa detect();
+
+    Kernel kernel(const isa& i);
+
+    std::string as_s(const isa& i);
+
+    void triangles_scalar(const Triangles&, const Values&);
+    void triangles_sse2(const Triangles&, const Values&);
+    void triangles_avx2(const Triangles&, const Values&);
+    void triangles_avx512(const Triangles&, const Values&);
+}
+
+#endif // INDICATORS_SIMD_HH
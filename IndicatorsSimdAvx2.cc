@@ -0,0 +1,59 @@
+#include "IndicatorsSimd.hh"
+
+// compiled with -mavx2 (/arch:AVX2), only called when detect() found AVX2
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#include "IndicatorsSimdKernel.hh"
+
+namespace
+{
+
+struct Avx2
+{
+    typedef __m256d type;
+    typedef __m256d mask;
+
+    static const size_t width = 4;
+
+    static type set1(const double _v) { return _mm256_set1_pd(_v); }
+    static type load(const double* _p) { return _mm256_loadu_pd(_p); }
+    static void store(double* _p, const type _v) { _mm256_storeu_pd(_p, _v); }
+
+    static type add(const type _a, const type _b) { return _mm256_add_pd(_a, _b); }
+    static type sub(const type _a, const type _b) { return _mm256_sub_pd(_a, _b); }
+    static type mul(const type _a, const type _b) { return _mm256_mul_pd(_a, _b); }
+    static type div(const type _a, const type _b) { return _mm256_div_pd(_a, _b); }
+    static type sqrt(const type _a) { return _mm256_sqrt_pd(_a); }
+
+    static mask lt(const type _a, const type _b) { return _mm256_cmp_pd(_a, _b, _CMP_LT_OQ); }
+    static mask le(const type _a, const type _b) { return _mm256_cmp_pd(_a, _b, _CMP_LE_OQ); }
+    static type select(const mask _m, const type _t, const type _f) { return _mm256_blendv_pd(_f, _t, _m); }
+
+    static type cbrt_estimate(const type _x)
+    {
+        // high words of the four lanes, divided by 3 and rebiased
+        const __m256i odd = _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7);
+        __m128i hi = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(_x), odd));
+        hi = _mm256_cvttpd_epi32(_mm256_mul_pd(_mm256_cvtepi32_pd(hi), _mm256_set1_pd(1.0 / 3.0)));
+        hi = _mm_add_epi32(hi, _mm_set1_epi32(715094163));
+        return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_cvtepu32_epi64(hi), 32));
+    }
+};
+
+}
+
+void indicatorsSimd::triangles_avx2(const Triangles& _t, const Values& _out)
+{
+    triangles<Avx2>(_t, _out);
+}
+
+#else
+
+void indicatorsSimd::triangles_avx2(const Triangles& _t, const Values& _out)
+{
+    triangles_sse2(_t, _out);
+}
+
+#endif
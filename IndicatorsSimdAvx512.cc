@@ -0,0 +1,58 @@
+#include "IndicatorsSimd.hh"
+
+// compiled with -mavx512f (/arch:AVX512), only called when detect() found AVX-512
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+#include "IndicatorsSimdKernel.hh"
+
+namespace
+{
+
+struct Avx512
+{
+    typedef __m512d type;
+    typedef __mmask8 mask;
+
+    static const size_t width = 8;
+
+    static type set1(const double _v) { return _mm512_set1_pd(_v); }
+    static type load(const double* _p) { return _mm512_loadu_pd(_p); }
+    static void store(double* _p, const type _v) { _mm512_storeu_pd(_p, _v); }
+
+    static type add(const type _a, const type _b) { return _mm512_add_pd(_a, _b); }
+    static type sub(const type _a, const type _b) { return _mm512_sub_pd(_a, _b); }
+    static type mul(const type _a, const type _b) { return _mm512_mul_pd(_a, _b); }
+    static type div(const type _a, const type _b) { return _mm512_div_pd(_a, _b); }
+    static type sqrt(const type _a) { return _mm512_sqrt_pd(_a); }
+
+    static mask lt(const type _a, const type _b) { return _mm512_cmp_pd_mask(_a, _b, _CMP_LT_OQ); }
+    static mask le(const type _a, const type _b) { return _mm512_cmp_pd_mask(_a, _b, _CMP_LE_OQ); }
+    static type select(const mask _m, const type _t, const type _f) { return _mm512_mask_blend_pd(_m, _f, _t); }
+
+    static type cbrt_estimate(const type _x)
+    {
+        // high words of the eight lanes, divided by 3 and rebiased
+        __m256i hi = _mm512_cvtepi64_epi32(_mm512_srli_epi64(_mm512_castpd_si512(_x), 32));
+        hi = _mm512_cvttpd_epi32(_mm512_mul_pd(_mm512_cvtepi32_pd(hi), _mm512_set1_pd(1.0 / 3.0)));
+        hi = _mm256_add_epi32(hi, _mm256_set1_epi32(715094163));
+        return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_cvtepu32_epi64(hi), 32));
+    }
+};
+
+}
+
+void indicatorsSimd::triangles_avx512(const Triangles& _t, const Values& _out)
+{
+    triangles<Avx512>(_t, _out);
+}
+
+#else
+
+void indicatorsSimd::triangles_avx512(const Triangles& _t, const Values& _out)
+{
+    triangles_avx2(_t, _out);
+}
+
+#endif
@@ -0,0 +1,130 @@
+#ifndef INDICATORS_SIMD_KERNEL_HH
+#define INDICATORS_SIMD_KERNEL_HH
+
+// generic body of the vector triangle kernels, included by one translation unit per instruction set
+// with V providing the lane type and operations, everything has internal linkage so the per-isa
+// instantiations cannot be merged by the linker
+
+#include "IndicatorsSimd.hh"
+
+#include <cfloat>
+
+namespace
+{
+
+// cube root of non-negative lanes, high-word estimate as in fdlibm followed by Newton iterations
+template<class V>
+inline typename V::type cbrt(const typename V::type _x)
+{
+    typedef typename V::type T;
+
+    // bring subnormal lanes into the normal range, cbrt(x * 2^162) = cbrt(x) * 2^54
+    const auto subnormal = V::lt(_x, V::set1(DBL_MIN));
+    const T x = V::select(subnormal, V::mul(_x, V::set1(0x1p162)), _x);
+
+    T y = V::cbrt_estimate(x);
+
+    const T third = V::set1(1.0 / 3.0);
+    for (int k(0); k < 4; ++k)
+    {
+        // y = (2y + x/y^2) / 3
+        y = V::mul(V::add(V::add(y, y), V::div(x, V::mul(y, y))), third);
+    }
+
+    y = V::select(subnormal, V::mul(y, V::set1(0x1p-54)), y);
+    return V::select(V::le(_x, V::set1(0.0)), V::set1(0.0), y);
+}
+
+template<class V>
+void triangles(const indicatorsSimd::Triangles& _t, const indicatorsSimd::Values& _out)
+{
+    typedef typename V::type T;
+
+    const T zero = V::set1(0.0);
+    const T quarter = V::set1(0.25);
+    const T half = V::set1(0.5);
+    const T three = V::set1(3.0);
+    const T four = V::set1(4.0);
+    const T flt_min = V::set1(FLT_MIN);
+    const T flt_max = V::set1(FLT_MAX);
+    const T dbl_min = V::set1(DBL_MIN);
+
+    const bool cached = _t.sqr_e[0] && _t.sqr_e[1] && _t.sqr_e[2];
+
+    for (size_t i(0); i < _t.n; i += V::width)
+    {
+        const T v0x = V::load(_t.c[0] + i), v0y = V::load(_t.c[1] + i), v0z = V::load(_t.c[2] + i);
+        const T v1x = V::load(_t.c[3] + i), v1y = V::load(_t.c[4] + i), v1z = V::load(_t.c[5] + i);
+        const T v2x = V::load(_t.c[6] + i), v2y = V::load(_t.c[7] + i), v2z = V::load(_t.c[8] + i);
+
+        // edges v0v1, v0v2, v1v2
+        const T ax = V::sub(v1x, v0x), ay = V::sub(v1y, v0y), az = V::sub(v1z, v0z);
+        const T bx = V::sub(v2x, v0x), by = V::sub(v2y, v0y), bz = V::sub(v2z, v0z);
+
+        T sqr_e1, sqr_e2, sqr_e3;
+        if (cached)
+        {
+            sqr_e1 = V::load(_t.sqr_e[0] + i);
+            sqr_e2 = V::load(_t.sqr_e[1] + i);
+            sqr_e3 = V::load(_t.sqr_e[2] + i);
+        }
+          else
+        {
+            const T cx = V::sub(v2x, v1x), cy = V::sub(v2y, v1y), cz = V::sub(v2z, v1z);
+
+            sqr_e1 = V::add(V::add(V::mul(ax, ax), V::mul(ay, ay)), V::mul(az, az));
+            sqr_e2 = V::add(V::add(V::mul(cx, cx), V::mul(cy, cy)), V::mul(cz, cz));
+            sqr_e3 = V::add(V::add(V::mul(bx, bx), V::mul(by, by)), V::mul(bz, bz));
+        }
+        const T sqr_sum = V::add(V::add(sqr_e1, sqr_e2), sqr_e3);
+
+        // |v0v1 x v0v2|^2
+        const T nx = V::sub(V::mul(ay, bz), V::mul(az, by));
+        const T ny = V::sub(V::mul(az, bx), V::mul(ax, bz));
+        const T nz = V::sub(V::mul(ax, by), V::mul(ay, bx));
+        const T cross = V::add(V::add(V::mul(nx, nx), V::mul(ny, ny)), V::mul(nz, nz));
+
+        const T area = V::sqrt(V::mul(quarter, cross));
+
+        if (_out.aspect_ratio)
+        {
+            // based on equ. 6 from paper
+            const T e1 = _t.e[0] ? V::load(_t.e[0] + i) : V::sqrt(sqr_e1);
+            const T e2 = _t.e[1] ? V::load(_t.e[1] + i) : V::sqrt(sqr_e2);
+            const T e3 = _t.e[2] ? V::load(_t.e[2] + i) : V::sqrt(sqr_e3);
+            const T semi_perimeter = V::mul(V::add(V::add(e1, e2), e3), half);
+            const T inradius = V::div(area, semi_perimeter);
+
+            // circumradius as ACG::Geometry::circumRadius, FLT_MAX for degenerated triangles
+            const T denom = V::mul(four, cross);
+            const T circum_sqr = V::div(V::mul(V::mul(sqr_e1, sqr_e3), sqr_e2), denom);
+            const T circumradius = V::sqrt(V::select(V::lt(denom, flt_min), flt_max, circum_sqr));
+
+            const T ar = V::div(inradius, circumradius);
+            V::store(_out.aspect_ratio + i, V::select(V::le(circumradius, dbl_min), zero, ar));
+        }
+
+        if (_out.interpolation_quality || _out.mean_ratio)
+        {
+            const T cbrt_product = cbrt<V>(V::mul(V::mul(sqr_e1, sqr_e2), sqr_e3));
+
+            // based on equ. 9 from paper, (e1 e2 e3)^(2/3) = cbrt(e1^2 e2^2 e3^2)
+            if (_out.interpolation_quality)
+                V::store(_out.interpolation_quality + i, V::div(area, cbrt_product));
+
+            // based on equ. 11 from paper
+            if (_out.mean_ratio)
+                V::store(_out.mean_ratio + i, V::div(V::mul(three, cbrt_product), sqr_sum));
+        }
+
+        if (_out.shape_regularity)
+        {
+            // based on equ. 14 from paper
+            V::store(_out.shape_regularity + i, V::div(V::mul(three, area), sqr_sum));
+        }
+    }
+}
+
+}
+
+#endif // INDICATORS_SIMD_KERNEL_HH
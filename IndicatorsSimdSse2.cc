@@ -0,0 +1,60 @@
+#include "IndicatorsSimd.hh"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+#include "IndicatorsSimdKernel.hh"
+
+namespace
+{
+
+struct Sse2
+{
+    typedef __m128d type;
+    typedef __m128d mask;
+
+    static const size_t width = 2;
+
+    static type set1(const double _v) { return _mm_set1_pd(_v); }
+    static type load(const double* _p) { return _mm_loadu_pd(_p); }
+    static void store(double* _p, const type _v) { _mm_storeu_pd(_p, _v); }
+
+    static type add(const type _a, const type _b) { return _mm_add_pd(_a, _b); }
+    static type sub(const type _a, const type _b) { return _mm_sub_pd(_a, _b); }
+    static type mul(const type _a, const type _b) { return _mm_mul_pd(_a, _b); }
+    static type div(const type _a, const type _b) { return _mm_div_pd(_a, _b); }
+    static type sqrt(const type _a) { return _mm_sqrt_pd(_a); }
+
+    static mask lt(const type _a, const type _b) { return _mm_cmplt_pd(_a, _b); }
+    static mask le(const type _a, const type _b) { return _mm_cmple_pd(_a, _b); }
+    static type select(const mask _m, const type _t, const type _f)
+    {
+        return _mm_or_pd(_mm_and_pd(_m, _t), _mm_andnot_pd(_m, _f));
+    }
+
+    static type cbrt_estimate(const type _x)
+    {
+        // high words of both lanes, divided by 3 and rebiased
+        __m128i hi = _mm_shuffle_epi32(_mm_castpd_si128(_x), _MM_SHUFFLE(3, 1, 3, 1));
+        hi = _mm_cvttpd_epi32(_mm_mul_pd(_mm_cvtepi32_pd(hi), _mm_set1_pd(1.0 / 3.0)));
+        hi = _mm_add_epi32(hi, _mm_set1_epi32(715094163));
+        return _mm_castsi128_pd(_mm_unpacklo_epi32(_mm_setzero_si128(), hi));
+    }
+};
+
+}
+
+void indicatorsSimd::triangles_sse2(const Triangles& _t, const Values& _out)
+{
+    triangles<Sse2>(_t, _out);
+}
+
+#else
+
+void indicatorsSimd::triangles_sse2(const Triangles& _t, const Values& _out)
+{
+    triangles_scalar(_t, _out);
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "IndicatorsSnapshot.hh"
+
+#include <algorithm>
+#include <cmath>
+
+void IndicatorsSnapshot::clear()
+{
+    built_ = false;
+    arity_ = 0;
+    n_faces_ = 0;
+    n_vertices_ = 0;
+
+    x_.clear();
+    y_.clear();
+    z_.clear();
+
+    xf_.clear();
+    yf_.clear();
+    zf_.clear();
+
+    offsets_.clear();
+    indices_.clear();
+
+    face_edges_.clear();
+    edges_.clear();
+}
+
+void IndicatorsSnapshot::set_single_precision(const bool _single)
+{
+    if (_single == single_precision_)
+        return;
+
+    clear();
+    single_precision_ = _single;
+
+    // the arrays of the other precision are not used anymore
+    x_.shrink_to_fit();
+    y_.shrink_to_fit();
+    z_.shrink_to_fit();
+    xf_.shrink_to_fit();
+    yf_.shrink_to_fit();
+    zf_.shrink_to_fit();
+}
+
+void IndicatorsSnapshot::set_edge_cache(const bool _cache)
+{
+    if (_cache == edge_cache_)
+        return;
+
+    clear();
+    edge_cache_ = _cache;
+
+    face_edges_.shrink_to_fit();
+    edges_.shrink_to_fit();
+}
+
+void IndicatorsSnapshot::update_edges(const unsigned int* _faces, const size_t _n)
+{
+    if (!edge_cache_)
+        return;
+
+    for (size_t i(0); i < _n; ++i)
+    {
+        const unsigned int* v = face(_faces[i]);
+        const unsigned int* edges = face_edges(_faces[i]);
+        const size_t n = valence(_faces[i]);
+
+        for (size_t k(0); k < n; ++k)
+        {
+            set_edge(edges[k], v[k], v[(k + 1) % n]);
+        }
+    }
+}
+
+void IndicatorsSnapshot::set_origin(const Point& _min, const Point& _max)
+{
+    origin_ = Point(0, 0, 0);
+    if (n_vertices_ == 0)
+        return;
+
+    // multiple of the power of two below the extent, the coordinates stay within twice the extent
+    const double extent = std::max(_max[0] - _min[0], std::max(_max[1] - _min[1], _max[2] - _min[2]));
+    if (!(extent > 0) || !std::isfinite(extent))
+        return;
+
+    const double step = std::ldexp(1.0, std::ilogb(extent));
+    for (int c(0); c < 3; ++c)
+    {
+        origin_[c] = std::round((_min[c] + _max[c]) * 0.5 / step) * step;
+    }
+}
@@ -0,0 +1,376 @@
+#ifndef INDICATORS_SNAPSHOT_HH
+#define INDICATORS_SNAPSHOT_HH
+
+#include <ACG/Math/VectorT.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+// flat copy of the mesh geometry, vertex positions as x/y/z arrays and faces as an index buffer,
+// so the indicator loops stream through contiguous memory instead of circulating the halfedges
+class IndicatorsSnapshot
+{
+public:
+    using Point = ACG::Vec3d;
+
+    IndicatorsSnapshot(): built_(false), single_precision_(false), edge_cache_(false), arity_(0), n_faces_(0),
+    n_vertices_(0) {}
+
+    // coordinates are stored as float relative to the center of the bounding box, half the memory of the double
+    // ones, point() widens them again. changing it clears the snapshot
+    void set_single_precision(const bool _single);
+
+    bool single_precision() const { return single_precision_; }
+
+    // length and squared length of every mesh edge, computed once from the snapshot coordinates and shared by
+    // the faces around the edge, which read them through face_edges(). changing it clears the snapshot
+    void set_edge_cache(const bool _cache);
+
+    bool edge_cache() const { return edge_cache_; }
+
+    template<class MeshT>
+    void build(const MeshT& _mesh, const unsigned int _arity = 0);
+
+    // tetrahedral OpenVolumeMesh, the cells are stored in place of the faces with 4 vertices each
+    template<class MeshT>
+    void build_tetrahedra(const MeshT& _mesh);
+
+    void clear();
+
+    // copies the vertex positions that differ from the mesh and appends their indices to _moved
+    template<class MeshT>
+    void update_points(const MeshT& _mesh, std::vector<unsigned int>& _moved);
+
+    // copies the positions of the given vertices, entries past the vertex count are ignored
+    template<class MeshT>
+    void update_points(const MeshT& _mesh, const unsigned int* _vertices, const size_t _n);
+
+    // recomputes the cached edges of the given faces after update_points(), nothing without the edge cache
+    void update_edges(const unsigned int* _faces, const size_t _n);
+
+    // same element counts as the mesh, geometry edits are not detected and need a clear() or update_points()
+    template<class MeshT>
+    bool valid_for(const MeshT& _mesh) const
+    {
+        return built_ && n_faces_ == _mesh.n_faces() && n_vertices_ == _mesh.n_vertices();
+    }
+
+    template<class MeshT>
+    bool valid_for_tetrahedra(const MeshT& _mesh) const
+    {
+        return built_ && arity_ == 4 && n_faces_ == _mesh.n_cells() && n_vertices_ == _mesh.n_vertices();
+    }
+
+    size_t n_faces() const { return n_faces_; }
+
+    size_t n_vertices() const { return n_vertices_; }
+
+    Point point(const unsigned int _v) const
+    {
+        if (single_precision_)
+            return Point(xf_[_v] + origin_[0], yf_[_v] + origin_[1], zf_[_v] + origin_[2]);
+
+        return Point(x_[_v], y_[_v], z_[_v]);
+    }
+
+    size_t valence(const size_t _f) const
+    {
+        return arity_ ? arity_ : offsets_[_f + 1] - offsets_[_f];
+    }
+
+    // vertex indices of face _f in fv_iter order
+    const unsigned int* face(const size_t _f) const
+    {
+        return arity_ ? &indices_[_f * arity_] : &indices_[offsets_[_f]];
+    }
+
+    // edge indices of face _f, the k-th one joins the corners k and k+1 of face(_f). only with the edge cache
+    const unsigned int* face_edges(const size_t _f) const
+    {
+        return arity_ ? &face_edges_[_f * arity_] : &face_edges_[offsets_[_f]];
+    }
+
+    double edge_sqr_length(const unsigned int _e) const { return edges_[2 * _e]; }
+
+    double edge_length(const unsigned int _e) const { return edges_[2 * _e + 1]; }
+
+    // empty in single precision
+    const double* x() const { return x_.data(); }
+    const double* y() const { return y_.data(); }
+    const double* z() const { return z_.data(); }
+
+private:
+    void resize_points(const size_t _n_vertices);
+
+    // center of the box, rounded so that edits which barely change the box keep the same origin
+    void set_origin(const Point& _min, const Point& _max);
+
+    // grows the box [_min, _max] to _p
+    template<class PointT>
+    static void extend(Point& _min, Point& _max, const PointT& _p);
+
+    template<class PointT>
+    void set_point(const unsigned int _v, const PointT& _p);
+
+    // whether the stored position of _v differs from _p
+    template<class PointT>
+    bool moved(const unsigned int _v, const PointT& _p) const;
+
+    // face to edge indices of the faces in indices_ order, the edges are computed when first seen
+    template<class MeshT>
+    void build_edges(const MeshT& _mesh);
+
+    // the squares do not depend on the direction of the edge, both faces around it get the same bits
+    void set_edge(const unsigned int _e, const unsigned int _a, const unsigned int _b)
+    {
+        edges_[2 * _e] = (point(_b) - point(_a)).sqrnorm();
+        edges_[2 * _e + 1] = std::sqrt(edges_[2 * _e]);
+    }
+
+private:
+    bool built_;
+    bool single_precision_;
+    bool edge_cache_;
+
+    // faces all have arity_ vertices, 0 when they are stored with offsets_ (CSR)
+    unsigned int arity_;
+    size_t n_faces_;
+    size_t n_vertices_;
+
+    std::vector<double> x_;
+    std::vector<double> y_;
+    std::vector<double> z_;
+
+    // the float coordinates are relative to origin_, which keeps their rounding relative to the size of the mesh
+    // rather than to its distance to the origin
+    Point origin_;
+    std::vector<float> xf_;
+    std::vector<float> yf_;
+    std::vector<float> zf_;
+
+    std::vector<unsigned int> offsets_;
+    std::vector<unsigned int> indices_;
+
+    // edge of each corner, parallel to indices_, and the squared length and length of each edge next to each
+    // other since they are read together, in double whatever the precision of the coordinates
+    std::vector<unsigned int> face_edges_;
+    std::vector<double> edges_;
+};
+
+//====================================================================================================================//
+inline void IndicatorsSnapshot::resize_points(const size_t _n_vertices)
+{
+    n_vertices_ = _n_vertices;
+
+    if (single_precision_)
+    {
+        xf_.resize(_n_vertices);
+        yf_.resize(_n_vertices);
+        zf_.resize(_n_vertices);
+    }
+      else
+    {
+        x_.resize(_n_vertices);
+        y_.resize(_n_vertices);
+        z_.resize(_n_vertices);
+    }
+}
+
+template<class PointT>
+void IndicatorsSnapshot::extend(Point& _min, Point& _max, const PointT& _p)
+{
+    for (int c(0); c < 3; ++c)
+    {
+        _min[c] = std::min(_min[c], double(_p[c]));
+        _max[c] = std::max(_max[c], double(_p[c]));
+    }
+}
+
+template<class PointT>
+void IndicatorsSnapshot::set_point(const unsigned int _v, const PointT& _p)
+{
+    if (single_precision_)
+    {
+        xf_[_v] = _p[0] - origin_[0];
+        yf_[_v] = _p[1] - origin_[1];
+        zf_[_v] = _p[2] - origin_[2];
+    }
+      else
+    {
+        x_[_v] = _p[0];
+        y_[_v] = _p[1];
+        z_[_v] = _p[2];
+    }
+}
+
+template<class PointT>
+bool IndicatorsSnapshot::moved(const unsigned int _v, const PointT& _p) const
+{
+    if (single_precision_)
+        return xf_[_v] != float(_p[0] - origin_[0]) || yf_[_v] != float(_p[1] - origin_[1])
+            || zf_[_v] != float(_p[2] - origin_[2]);
+
+    return x_[_v] != _p[0] || y_[_v] != _p[1] || z_[_v] != _p[2];
+}
+
+template<class MeshT>
+void IndicatorsSnapshot::build(const MeshT& _mesh, const unsigned int _arity)
+{
+    clear();
+
+    arity_ = _arity;
+    n_faces_ = _mesh.n_faces();
+
+    resize_points(_mesh.n_vertices());
+
+    if (single_precision_)
+    {
+        Point min(std::numeric_limits<double>::max()), max(-std::numeric_limits<double>::max());
+        for (auto vh: _mesh.vertices())
+        {
+            extend(min, max, _mesh.point(vh));
+        }
+        set_origin(min, max);
+    }
+
+    for (auto vh: _mesh.vertices())
+    {
+        set_point(vh.idx(), _mesh.point(vh));
+    }
+
+    if (arity_)
+    {
+        indices_.reserve(n_faces_ * arity_);
+    }
+      else
+    {
+        offsets_.reserve(n_faces_ + 1);
+        offsets_.push_back(0);
+    }
+
+    for (auto fh: _mesh.faces())
+    {
+        for (auto vh_iter = _mesh.fv_iter(fh); vh_iter.is_valid(); ++vh_iter)
+        {
+            indices_.push_back((*vh_iter).idx());
+        }
+
+        if (!arity_)
+        {
+            offsets_.push_back(indices_.size());
+        }
+    }
+
+    if (edge_cache_)
+        build_edges(_mesh);
+
+    built_ = true;
+}
+
+template<class MeshT>
+void IndicatorsSnapshot::build_edges(const MeshT& _mesh)
+{
+    face_edges_.resize(indices_.size());
+    edges_.resize(2 * _mesh.n_edges());
+
+    std::vector<bool> done(_mesh.n_edges(), false);
+
+    for (auto fh: _mesh.faces())
+    {
+        const size_t f = fh.idx();
+        const unsigned int* v = face(f);
+        unsigned int* edges = arity_ ? &face_edges_[f * arity_] : &face_edges_[offsets_[f]];
+        const size_t n = valence(f);
+
+        // the halfedges do not have to start at the first corner of fv_iter, they are matched by their origin
+        for (auto he_iter = _mesh.cfh_iter(fh); he_iter.is_valid(); ++he_iter)
+        {
+            const unsigned int from = _mesh.from_vertex_handle(*he_iter).idx();
+            const unsigned int e = _mesh.edge_handle(*he_iter).idx();
+
+            for (size_t k(0); k < n; ++k)
+            {
+                if (v[k] != from)
+                    continue;
+
+                edges[k] = e;
+                if (!done[e])
+                {
+                    set_edge(e, from, v[(k + 1) % n]);
+                    done[e] = true;
+                }
+                break;
+            }
+        }
+    }
+}
+
+template<class MeshT>
+void IndicatorsSnapshot::build_tetrahedra(const MeshT& _mesh)
+{
+    clear();
+
+    arity_ = 4;
+    n_faces_ = _mesh.n_cells();
+
+    resize_points(_mesh.n_vertices());
+
+    if (single_precision_)
+    {
+        Point min(std::numeric_limits<double>::max()), max(-std::numeric_limits<double>::max());
+        for (auto vh: _mesh.vertices())
+        {
+            extend(min, max, _mesh.vertex(vh));
+        }
+        set_origin(min, max);
+    }
+
+    for (auto vh: _mesh.vertices())
+    {
+        set_point(vh.idx(), _mesh.vertex(vh));
+    }
+
+    indices_.reserve(n_faces_ * 4);
+    for (auto ch: _mesh.cells())
+    {
+        for (auto vh: _mesh.get_cell_vertices(ch))
+        {
+            indices_.push_back(vh.idx());
+        }
+    }
+
+    built_ = true;
+}
+
+template<class MeshT>
+void IndicatorsSnapshot::update_points(const MeshT& _mesh, std::vector<unsigned int>& _moved)
+{
+    for (auto vh: _mesh.vertices())
+    {
+        const auto& p = _mesh.point(vh);
+        const unsigned int v = vh.idx();
+
+        if (moved(v, p))
+        {
+            set_point(v, p);
+            _moved.push_back(v);
+        }
+    }
+}
+
+template<class MeshT>
+void IndicatorsSnapshot::update_points(const MeshT& _mesh, const unsigned int* _vertices, const size_t _n)
+{
+    for (size_t i(0); i < _n; ++i)
+    {
+        const unsigned int v = _vertices[i];
+        if (v >= n_vertices_)
+            continue;
+
+        set_point(v, _mesh.point(_mesh.vertex_handle(v)));
+    }
+}
+
+#endif // INDICATORS_SNAPSHOT_HH
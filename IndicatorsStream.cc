@@ -0,0 +1,154 @@
+#include "IndicatorsStream.hh"
+
+#include <cstring>
+
+bool IndicatorsStream::open(const std::string& _mesh, const std::string& _values)
+{
+    values_.close();
+    values_path_ = _values;
+
+    if (!IndicatorsColumns::little_endian() || !mesh_.open(_mesh) || mesh_.size() < sizeof(Header))
+    {
+        mesh_.close();
+        return false;
+    }
+
+    const Header& h = header();
+    const bool tri = h.flags & triangles_flag;
+
+    // the parts must fit in the file, counted so that the sizes cannot overflow
+    uint64_t left = mesh_.size() - sizeof(Header);
+    auto take = [&](const uint64_t _count, const uint64_t _size)
+    {
+        if (_count > left / _size)
+            return false;
+        left -= _count * _size;
+        return true;
+    };
+
+    const bool valid = std::memcmp(h.magic, "IMESH\0\0\0", 8) == 0 && h.version == 1 && take(h.n_vertices, 3 * sizeof(double))
+        && (tri ? h.n_faces <= left / (3 * sizeof(uint32_t)) && h.n_indices == 3 * h.n_faces : take(h.n_faces + 1, sizeof(uint64_t)))
+        && take(h.n_indices, sizeof(uint32_t));
+
+    if (!valid)
+    {
+        mesh_.close();
+        return false;
+    }
+
+    points_ = reinterpret_cast<const double*>(mesh_.data() + sizeof(Header));
+    offsets_ = tri ? nullptr : reinterpret_cast<const uint64_t*>(points_ + 3 * h.n_vertices);
+    indices_ = reinterpret_cast<const uint32_t*>(tri ? reinterpret_cast<const char*>(points_ + 3 * h.n_vertices)
+        : reinterpret_cast<const char*>(offsets_ + h.n_faces + 1));
+
+    return true;
+}
+
+bool IndicatorsStream::get_triangle(const size_t _f, indicatorsRegistry::Triangle& _tr) const
+{
+    const uint32_t* v = indices_ + 3 * _f;
+    const uint64_t n = header().n_vertices;
+    if (v[0] >= n || v[1] >= n || v[2] >= n)
+        return false;
+
+    _tr.v0 = point(v[0]);
+    _tr.v1 = point(v[1]);
+    _tr.v2 = point(v[2]);
+
+    return true;
+}
+
+bool IndicatorsStream::get_polygon(const size_t _f, std::vector<Point>& _points) const
+{
+    const uint64_t begin = offsets_[_f], end = offsets_[_f + 1];
+    if (begin > end || end > header().n_indices)
+        return false;
+
+    // reuses the capacity of the buffer across faces
+    _points.resize(end - begin);
+    for (size_t i(0); i < _points.size(); ++i)
+    {
+        const uint32_t v = indices_[begin + i];
+        if (v >= header().n_vertices)
+            return false;
+
+        _points[i] = point(v);
+    }
+
+    return true;
+}
+
+bool IndicatorsStream::hash_faces(const size_t _begin, const size_t _end, uint64_t& _hash) const
+{
+    IndicatorsColumns::Hash h;
+    for (size_t f(_begin); f < _end; ++f)
+    {
+        const uint64_t begin = offsets_ ? offsets_[f] : 3 * f;
+        const uint64_t end = offsets_ ? offsets_[f + 1] : 3 * f + 3;
+        if (begin > end || end > header().n_indices)
+            return false;
+
+        h.add(end - begin);
+        for (uint64_t i(begin); i < end; ++i)
+        {
+            h.add(static_cast<uint64_t>(indices_[i]));
+        }
+    }
+
+    _hash = h.value();
+    return true;
+}
+
+std::vector<uint64_t> IndicatorsStream::hash_points()
+{
+    const size_t n_vertices = this->n_vertices();
+    std::vector<uint64_t> hashes(n_chunks(n_vertices));
+
+    // the blocks are released as they are done, as the faces are
+    for (size_t base(0); base < n_vertices; base += stream_faces_)
+    {
+        const size_t n = std::min(stream_faces_, n_vertices - base);
+        for_each_chunk(n, [&](const size_t _chunk, const size_t _begin, const size_t _end)
+        {
+            IndicatorsColumns::Hash h;
+            for (size_t i(3 * (base + _begin)); i < 3 * (base + _end); ++i)
+            {
+                h.add(points_[i]);
+            }
+            hashes[base / chunk_size + _chunk] = h.value();
+        });
+
+        mesh_.release(sizeof(Header), (base + n) * 3 * sizeof(double));
+    }
+
+    return hashes;
+}
+
+bool IndicatorsStream::write_block(IndicatorsColumns::Writer& _writer, const size_t _begin, const size_t _n,
+    const size_t _n_values, const std::vector<double>& _values)
+{
+    bool written(true);
+    for (size_t k(0); k < _n_values; ++k)
+    {
+        written = _writer.write(k, _begin, &_values[k * _n], _n) && written;
+    }
+
+    // the faces of the block are not read again, and the points are mapped again by the next block from the page
+    // cache, so the pages held by the process do not grow with the mesh
+    mesh_.release(sizeof(Header), n_vertices() * 3 * sizeof(double));
+
+    if (triangles())
+    {
+        const size_t indices = reinterpret_cast<const char*>(indices_) - mesh_.data();
+        mesh_.release(indices + 3 * _begin * sizeof(uint32_t), 3 * _n * sizeof(uint32_t));
+    }
+      else
+    {
+        const size_t offsets = reinterpret_cast<const char*>(offsets_) - mesh_.data();
+        const size_t indices = reinterpret_cast<const char*>(indices_) - mesh_.data();
+        mesh_.release(offsets + _begin * sizeof(uint64_t), _n * sizeof(uint64_t));
+        mesh_.release(indices + offsets_[_begin] * sizeof(uint32_t), (offsets_[_begin + _n] - offsets_[_begin]) * sizeof(uint32_t));
+    }
+
+    return written;
+}
@@ -0,0 +1,375 @@
+#ifndef INDICATORS_STREAM_HH
+#define INDICATORS_STREAM_HH
+
+#include "Indicators.hh"
+#include "IndicatorsMapped.hh"
+#include "IndicatorsColumns.hh"
+#include "IndicatorsSimd.hh"
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// evaluation of a mesh streamed from a binary file, for the meshes that do not fit in memory as an OpenMesh mesh
+// with their face properties. the file is memory mapped and evaluated in blocks of stream_faces() faces, the
+// values of every block are written to a values file before the next one, so the memory held by the evaluation
+// depends on the block and not on the mesh. the results are those of IndicatorsTriangles on a file of triangles
+// and of IndicatorsPolygons otherwise. the values are kept in double, set_single_precision() has no effect
+//
+// mesh file, little endian as IndicatorsColumns and used in place, every part aligned on 8 bytes:
+//   header   "IMESH" padded to 8 bytes, uint32 version 1, uint32 flags, uint64 vertices, faces and indices
+//   points   3 doubles per vertex
+//   offsets  faces + 1 uint64, start of every face in the indices, absent when flags has triangles
+//   indices  uint32 vertex indices of the faces
+//
+// values file: an IndicatorsColumns file of doubles with the content hash of the mesh, the load_values() of
+// IndicatorsTriangles or IndicatorsPolygons takes it for the same mesh loaded in memory
+class IndicatorsStream : public Indicators
+{
+public:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t flags;
+        uint64_t n_vertices;
+        uint64_t n_faces;
+        uint64_t n_indices;
+    };
+
+    // every face is a triangle, the file has no offsets
+    static constexpr uint32_t triangles_flag = 1;
+
+    IndicatorsStream(const unsigned int _seed = std::minstd_rand::default_seed):
+    Indicators(), isa_(indicatorsSimd::detect()), seed_(_seed), stream_faces_(64 * chunk_size),
+    points_(nullptr), offsets_(nullptr), indices_(nullptr), failed_(false)
+    {
+    }
+
+    virtual ~IndicatorsStream() {}
+
+    // maps _mesh, the evaluations write the values to _values. false when _mesh is not a mesh file or the host is
+    // big endian
+    bool open(const std::string& _mesh, const std::string& _values);
+
+    // writes _mesh as a mesh file, false on a big endian host
+    template<class MeshT>
+    static bool write(const MeshT& _mesh, const std::string& _path);
+
+public:
+    virtual std::vector<Result> compute_all(const std::vector<indicatorsType::indicators>& _indicators) override
+    {
+        return compute_list(indicatorsRegistry::All(), _indicators);
+    }
+
+    // the indicators Is only, in a loop instantiated for them, e.g. compute<indicatorsRegistry::MeanRatio>()
+    template<class... Is>
+    std::vector<Result> compute()
+    {
+        return compute_list(indicatorsRegistry::List<Is...>(), indicatorsRegistry::ids(indicatorsRegistry::List<Is...>()));
+    }
+
+    // value of face _f read back from the values file of the last evaluation, 0 when _i was not evaluated
+    virtual double value(const indicatorsType::indicators& _i, const size_t _f) const override
+    {
+        return values_.value(_i, _f);
+    }
+
+    // there is no mesh to select in, the faces of _result.worst are its indices in the file
+    virtual void select_worst(const Result&) override {}
+
+    size_t n_faces() const { return mesh_.is_open() ? header().n_faces : 0; }
+
+    size_t n_vertices() const { return mesh_.is_open() ? header().n_vertices : 0; }
+
+    bool triangles() const { return mesh_.is_open() && (header().flags & triangles_flag); }
+
+    // faces evaluated per block, rounded up to the chunks of the parallel loops so that the sums are reduced as
+    // on a loaded mesh. the values of a block take 8 bytes per face and evaluated indicator
+    void set_stream_faces(const size_t _faces) { stream_faces_ = std::max<size_t>(1, n_chunks(_faces)) * chunk_size; }
+
+    size_t stream_faces() const { return stream_faces_; }
+
+    // instruction set of the batched triangle kernels, limited to what the cpu supports
+    void set_isa(const indicatorsSimd::isa& _isa) { isa_ = std::min(_isa, indicatorsSimd::detect()); }
+
+    // seed of the point shuffling in the enclosing sphere computation, as IndicatorsPolygons
+    void set_seed(const unsigned int _seed) { seed_ = _seed; }
+
+    // the last evaluation found a face with a vertex index out of range or invalid offsets, or could not write
+    // the values file, its results are undefined
+    bool failed() const { return failed_; }
+
+private:
+    const Header& header() const { return *reinterpret_cast<const Header*>(mesh_.data()); }
+
+    Point point(const size_t _v) const { return Point(points_[3 * _v], points_[3 * _v + 1], points_[3 * _v + 2]); }
+
+    // false when a vertex of the face is out of range
+    bool get_triangle(const size_t _f, indicatorsRegistry::Triangle& _tr) const;
+
+    bool get_polygon(const size_t _f, std::vector<Point>& _points) const;
+
+    // face source of evaluate_triangles() and evaluate_polygons(), the faces of a block read from the file. the
+    // file has no edge cache
+    struct Source
+    {
+        const IndicatorsStream& stream;
+        size_t base;
+
+        size_t face(const size_t _i) const { return base + _i; }
+
+        bool triangle(const size_t _i, indicatorsRegistry::Triangle& _tr) const { return stream.get_triangle(base + _i, _tr); }
+
+        bool polygon(const size_t _i, std::vector<Point>& _points) const { return stream.get_polygon(base + _i, _points); }
+
+        bool cached() const { return false; }
+
+        void edges(const size_t, double*, double*) const {}
+    };
+
+    // IndicatorsColumns::Hash of the faces [_begin, _end), false when their offsets are invalid
+    bool hash_faces(const size_t _begin, const size_t _end, uint64_t& _hash) const;
+
+    // hashes of the chunks of points, read block by block
+    std::vector<uint64_t> hash_points();
+
+    // fused traversal of the indicators of the list, the requested ones not in it are undefined
+    template<class... Is>
+    std::vector<Result> compute_list(indicatorsRegistry::List<Is...>, const std::vector<indicatorsType::indicators>&);
+
+    // writes the values of the faces [_begin, _begin + _n) of the active indicators, _values holding _n per
+    // indicator, and releases the pages of their faces in the mesh file
+    bool write_block(IndicatorsColumns::Writer&, const size_t _begin, const size_t _n, const size_t _n_values,
+        const std::vector<double>& _values);
+
+    // no colors without a mesh
+    virtual void color_coding(const indicatorsType::indicators&, const double, const double) override {}
+
+private:
+    indicatorsSimd::isa isa_;
+
+    unsigned int seed_;
+
+    size_t stream_faces_;
+
+    IndicatorsMapped mesh_;
+    const double* points_;
+    const uint64_t* offsets_;
+    const uint32_t* indices_;
+
+    std::string values_path_;
+
+    // values file of the last evaluation
+    IndicatorsColumns values_;
+
+    bool failed_;
+};
+
+//====================================================================================================================//
+template<class MeshT>
+bool IndicatorsStream::write(const MeshT& _mesh, const std::string& _path)
+{
+    if (!IndicatorsColumns::little_endian())
+        return false;
+
+    std::ofstream out(_path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    Header header = {{'I', 'M', 'E', 'S', 'H', 0, 0, 0}, 1, triangles_flag, static_cast<uint64_t>(_mesh.n_vertices()),
+        static_cast<uint64_t>(_mesh.n_faces()), 0};
+    for (auto fh: _mesh.faces())
+    {
+        const size_t valence = _mesh.valence(fh);
+        header.n_indices += valence;
+        if (valence != 3)
+            header.flags &= ~triangles_flag;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // written through a bounded buffer, as the file may be larger than the memory left
+    std::vector<char> buffer;
+    auto put = [&](const void* _data, const size_t _size)
+    {
+        buffer.insert(buffer.end(), static_cast<const char*>(_data), static_cast<const char*>(_data) + _size);
+        if (buffer.size() >= (1u << 20))
+        {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    };
+
+    for (auto vh: _mesh.vertices())
+    {
+        const auto& p = _mesh.point(vh);
+        const double c[3] = {double(p[0]), double(p[1]), double(p[2])};
+        put(c, sizeof(c));
+    }
+
+    if (!(header.flags & triangles_flag))
+    {
+        uint64_t offset(0);
+        put(&offset, sizeof(offset));
+        for (auto fh: _mesh.faces())
+        {
+            offset += _mesh.valence(fh);
+            put(&offset, sizeof(offset));
+        }
+    }
+
+    for (auto fh: _mesh.faces())
+    {
+        for (auto fv_it = _mesh.cfv_iter(fh); fv_it.is_valid(); ++fv_it)
+        {
+            const uint32_t v = static_cast<uint32_t>((*fv_it).idx());
+            put(&v, sizeof(v));
+        }
+    }
+
+    out.write(buffer.data(), buffer.size());
+    return static_cast<bool>(out);
+}
+
+template<class... Is>
+std::vector<Indicators::Result> IndicatorsStream::compute_list(indicatorsRegistry::List<Is...> _list,
+    const std::vector<indicatorsType::indicators>& _indicators)
+{
+    // one pass over the blocks of the file, each evaluated by the parallel loops as a loaded mesh would be and
+    // reduced chunk by chunk into the results before its values are written out
+    const IndicatorsProfile::Run run(profile_);
+
+    bool defined[indicatorsType::n_indicators];
+    if (triangles())
+        indicatorsRegistry::defined<indicatorsRegistry::Triangle>(_list, defined);
+      else
+        indicatorsRegistry::defined<indicatorsRegistry::Polygon>(_list, defined);
+
+    const Request request = this->request(_indicators, defined);
+    const std::vector<indicatorsType::indicators>& active = request.active;
+
+    values_.close();
+    failed_ = false;
+
+    const size_t n_faces = this->n_faces();
+    const size_t n_values = active.size();
+
+    // an empty mesh has no result for any of them
+    IndicatorsColumns::Writer writer;
+    if (active.empty() || !n_faces || !writer.create(values_path_, n_faces, sizeof(double), active))
+        return results(_indicators, this->request({}, defined), {});
+
+    // the content hash of the values file, the faces are hashed by the chunks that evaluate them
+    IndicatorsProfile::Timer geometry(profile_, IndicatorsProfile::GEOMETRY);
+    const std::vector<uint64_t> point_hashes = hash_points();
+    geometry.stop();
+
+    std::vector<uint64_t> face_hashes(n_chunks(n_faces));
+
+    const indicatorsSimd::Kernel kernel = indicatorsSimd::kernel(isa_);
+
+    std::vector<double> values;
+    std::vector<Reduction> reductions(n_values);
+    std::vector<IndicatorsDistribution> distributions(n_values, distribution());
+    std::vector<IndicatorsWorst> worst;
+    for (auto i: active)
+    {
+        worst.push_back(this->worst(i));
+    }
+
+    std::atomic<bool> failed(false);
+
+    for (size_t base(0); base < n_faces && !cancelled() && !failed; base += stream_faces_)
+    {
+        const size_t n = std::min(stream_faces_, n_faces - base);
+        values.resize(n * n_values);
+
+        // the chunks only keep the faces worse than the ones found in the previous blocks
+        std::vector<IndicatorsWorst> block_worst;
+        for (size_t k(0); k < n_values; ++k)
+        {
+            block_worst.push_back(this->worst(active[k]));
+            block_worst[k].limit(worst[k]);
+        }
+
+        std::vector<Reduction> partials;
+        std::vector<IndicatorsDistribution> block_distributions;
+
+        IndicatorsProfile::Timer kernels(profile_, IndicatorsProfile::KERNELS);
+        profile_.add(IndicatorsProfile::FACES, n);
+
+        reduce_chunks(n, n_values, partials, block_distributions, block_worst,
+            [&](const size_t _chunk, const size_t _begin, const size_t _end, Reduction* _reductions)
+        {
+            if (!hash_faces(base + _begin, base + _end, face_hashes[base / chunk_size + _chunk]))
+            {
+                failed = true;
+                return;
+            }
+
+            auto store = [&](const size_t _i, const size_t _k, const double _value)
+            {
+                values[_k * n + _i] = _value;
+                _reductions[_k].add(base + _i, _value);
+            };
+
+            // as IndicatorsTriangles and IndicatorsPolygons, on the faces of the block read from the file
+            const Source source = {*this, base};
+            if (triangles())
+            {
+                if (!evaluate_triangles(_list, source, _begin, _end, kernel, request, store))
+                    failed = true;
+            }
+              else
+            {
+                thread_local indicatorsRegistry::Workspace workspace;
+                if (!evaluate_polygons(_list, source, _begin, _end, nullptr, seed_, workspace, request, store))
+                    failed = true;
+            }
+        });
+
+        kernels.stop();
+
+        // the chunks of a block are merged in order, so the sums are those of a single pass over the mesh
+        for (size_t p(0); p < partials.size(); ++p)
+        {
+            reductions[p % n_values].merge(partials[p]);
+        }
+
+        for (size_t k(0); k < n_values; ++k)
+        {
+            distributions[k].merge(block_distributions[k]);
+            worst[k].merge(block_worst[k]);
+        }
+
+        const IndicatorsProfile::Timer columns(profile_, IndicatorsProfile::COLUMNS);
+        if (!cancelled() && !failed && !write_block(writer, base, n, n_values, values))
+            failed = true;
+    }
+
+    {
+        const IndicatorsProfile::Timer columns(profile_, IndicatorsProfile::COLUMNS);
+        if (!cancelled() && !failed && !writer.finish(IndicatorsColumns::hash(n_vertices(), n_faces, point_hashes, face_hashes)))
+            failed = true;
+    }
+
+    failed_ = failed;
+    if (failed_)
+        return results(_indicators, this->request({}, defined), {});
+
+    for (size_t k(0); k < n_values; ++k)
+    {
+        reductions[k].distribution = distributions[k];
+        reductions[k].worst = worst[k];
+    }
+
+    if (!cancelled())
+        values_.open(values_path_);
+
+    return results(_indicators, request, reductions);
+}
+
+#endif // INDICATORS_STREAM_HH
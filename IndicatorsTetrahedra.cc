@@ -0,0 +1,68 @@
+#include "IndicatorsTetrahedra.hh"
+
+void IndicatorsTetrahedra::update_snapshot()
+{
+    if (!snapshot_.valid_for_tetrahedra(mesh_))
+    {
+        snapshot_.build_tetrahedra(mesh_);
+    }
+}
+
+indicatorsRegistry::Tetrahedron IndicatorsTetrahedra::get_tetrahedron(const size_t _c) const
+{
+    const unsigned int* v = snapshot_.face(_c);
+
+    Point points[4];
+    for (size_t i(0); i < 4; ++i)
+    {
+        points[i] = snapshot_.point(v[i]);
+    }
+
+    return indicatorsRegistry::Tetrahedron(points);
+}
+
+const OpenVolumeMesh::CellPropertyT<double>* IndicatorsTetrahedra::cell_property(const indicatorsType::indicators& _i) const
+{
+    const int index = cell_index_[_i];
+    return index >= 0 ? &cell_properties_[index] : nullptr;
+}
+
+OpenVolumeMesh::CellPropertyT<double>* IndicatorsTetrahedra::cell_property(const indicatorsType::indicators& _i)
+{
+    return const_cast<OpenVolumeMesh::CellPropertyT<double>*>(static_cast<const IndicatorsTetrahedra*>(this)->cell_property(_i));
+}
+
+//====================================================================================================================//
+void IndicatorsTetrahedra::select_worst(const Result& _result)
+{
+    if (!status_)
+        return;
+
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::SELECT);
+
+    for (auto ch: mesh_.cells())
+    {
+        (*status_)[ch].set_selected(false);
+    }
+
+    for (const auto& cell: _result.worst.faces())
+    {
+        (*status_)[OpenVolumeMesh::CellHandle(cell.face)].set_selected(true);
+    }
+}
+
+void IndicatorsTetrahedra::color_cells(const OpenVolumeMesh::CellPropertyT<double>& _cprop, const double _min_value, const double _max_value)
+{
+    if (!colors_)
+        return;
+
+    const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::COLOR);
+
+    const ColorMap color = color_map(_min_value, _max_value);
+
+    // the color attribute flags itself on every write, so the cells are colored on one thread
+    for (auto ch: mesh_.cells())
+    {
+        (*colors_)[ch] = color(_cprop[ch]);
+    }
+}
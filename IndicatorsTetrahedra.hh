@@ -0,0 +1,182 @@
+#ifndef INDICATORS_TETRAHEDRA_HH
+#define INDICATORS_TETRAHEDRA_HH
+
+#include "Indicators.hh"
+
+#include <ObjectTypes/TetrahedralMesh/TetrahedralMesh.hh>
+#include <OpenVolumeMesh/Attribs/ColorAttrib.hh>
+#include <OpenVolumeMesh/Attribs/StatusAttrib.hh>
+
+// volumetric counterparts of the triangle indicators, evaluated per cell of a tetrahedral OpenVolumeMesh.
+// they are scaled to 1 for the regular tetrahedron, warping and taper are not defined. in single precision only
+// the snapshot is stored as float, the cell properties stay double
+class IndicatorsTetrahedra : public Indicators
+{
+public:
+    using Colors = OpenVolumeMesh::ColorAttrib<ACG::Vec4f>;
+    using Status = OpenVolumeMesh::StatusAttrib;
+
+    // cells are colored in _colors when given, and the worst ones selected in _status
+    IndicatorsTetrahedra(TetrahedralMesh& _mesh, Colors* _colors = nullptr, Status* _status = nullptr):
+    Indicators(), mesh_(_mesh), colors_(_colors), status_(_status)
+    {
+        for (const auto& entry: indicatorsRegistry::entries())
+        {
+            cell_index_[entry.id] = entry.tetrahedra ? static_cast<int>(cell_properties_.size()) : -1;
+            if (entry.tetrahedra)
+                cell_properties_.push_back(_mesh.request_cell_property<double>(entry.property));
+        }
+    }
+
+    // the cell properties are released with their handles
+    virtual ~IndicatorsTetrahedra() {}
+
+public:
+    virtual std::vector<Result> compute_all(const std::vector<indicatorsType::indicators>& _indicators) override
+    {
+        return compute_list(indicatorsRegistry::All(), _indicators);
+    }
+
+    // the indicators Is only, in a loop instantiated for them, e.g. compute<indicatorsRegistry::MeanRatio>()
+    template<class... Is>
+    std::vector<Result> compute()
+    {
+        return compute_list(indicatorsRegistry::List<Is...>(), indicatorsRegistry::ids(indicatorsRegistry::List<Is...>()));
+    }
+
+    // value of cell _f
+    virtual double value(const indicatorsType::indicators& _i, const size_t _f) const override
+    {
+        const OpenVolumeMesh::CellPropertyT<double>* prop = cell_property(_i);
+        return prop ? (*prop)[OpenVolumeMesh::CellHandle(_f)] : 0.0;
+    }
+
+    // cells are not evaluated incrementally, an edit flattens the mesh again
+    virtual void geometry_changed() override { invalidate_snapshot(); }
+
+    virtual void vertices_changed(const std::vector<unsigned int>&) override { invalidate_snapshot(); }
+
+    virtual void apply_colors(const indicatorsType::indicators& _i, const Result& _result) override
+    {
+        if (OpenVolumeMesh::CellPropertyT<double>* prop = cell_property(_i))
+            color_cells(*prop, _result.min, _result.max);
+    }
+
+    virtual void select_worst(const Result& _result) override;
+
+private:
+    void update_snapshot();
+
+    indicatorsRegistry::Tetrahedron get_tetrahedron(const size_t _c) const;
+
+    // fused traversal of the indicators of the list, the requested ones not in it are undefined
+    template<class... Is>
+    std::vector<Result> compute_list(indicatorsRegistry::List<Is...>, const std::vector<indicatorsType::indicators>&);
+
+    // null for the indicators not defined on tetrahedra
+    const OpenVolumeMesh::CellPropertyT<double>* cell_property(const indicatorsType::indicators&) const;
+
+    OpenVolumeMesh::CellPropertyT<double>* cell_property(const indicatorsType::indicators&);
+
+    void color_cells(const OpenVolumeMesh::CellPropertyT<double>&, const double, const double);
+
+    // tetrahedra have no face properties, see color_cells()
+    virtual void color_coding(const indicatorsType::indicators&, const double, const double) override {}
+
+private:
+    TetrahedralMesh& mesh_;
+
+    Colors* colors_;
+
+    Status* status_;
+
+    // properties of the indicators defined on tetrahedra, cell_index_ is the position of an indicator in
+    // cell_properties_ or -1
+    std::vector<OpenVolumeMesh::CellPropertyT<double>> cell_properties_;
+    int cell_index_[indicatorsType::n_indicators];
+};
+
+//====================================================================================================================//
+template<class... Is>
+std::vector<Indicators::Result> IndicatorsTetrahedra::compute_list(indicatorsRegistry::List<Is...> _list,
+    const std::vector<indicatorsType::indicators>& _indicators)
+{
+    // one traversal of the flattened cells, every requested indicator is derived from the shared edge lengths and
+    // volume of the cell
+    const IndicatorsProfile::Run run(profile_);
+
+    bool defined[indicatorsType::n_indicators];
+    indicatorsRegistry::defined<indicatorsRegistry::Tetrahedron>(_list, defined);
+
+    const Request request = this->request(_indicators, defined);
+    const std::vector<indicatorsType::indicators>& active = request.active;
+
+    // an empty mesh has no result for any of them
+    if (active.empty() || mesh_.n_cells() == 0)
+        return results(_indicators, this->request({}, defined), {});
+
+    {
+        const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::GEOMETRY);
+        update_snapshot();
+    }
+
+    const size_t n_cells = snapshot_.n_faces();
+    const size_t n_values = active.size();
+    std::vector<Reduction> partials;
+    std::vector<IndicatorsDistribution> distributions;
+
+    std::vector<OpenVolumeMesh::CellPropertyT<double>*> props;
+    for (auto i: active)
+    {
+        props.push_back(cell_property(i));
+    }
+
+    std::vector<IndicatorsWorst> worst;
+    for (auto i: active)
+    {
+        worst.push_back(this->worst(i));
+    }
+
+    IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::KERNELS);
+    profile_.add(IndicatorsProfile::FACES, n_cells);
+
+    reduce_chunks(n_cells, n_values, partials, distributions, worst,
+        [&](const size_t, const size_t _begin, const size_t _end, Reduction* _reductions)
+    {
+        double values[indicatorsType::n_indicators];
+
+        for (size_t c(_begin); c < _end; ++c)
+        {
+            const indicatorsRegistry::Tetrahedron tet = get_tetrahedron(c);
+            indicatorsRegistry::evaluate(_list, tet, request.slots, values);
+
+            for (size_t k(0); k < n_values; ++k)
+            {
+                (*props[k])[OpenVolumeMesh::CellHandle(c)] = values[k];
+                _reductions[k].add(c, values[k]);
+            }
+        }
+    });
+
+    timer.stop();
+
+    std::vector<Reduction> reductions(n_values);
+    for (size_t p(0); p < partials.size(); ++p)
+    {
+        reductions[p % n_values].merge(partials[p]);
+    }
+
+    for (size_t k(0); k < n_values; ++k)
+    {
+        reductions[k].distribution = distributions[k];
+        reductions[k].worst = worst[k];
+    }
+
+    const Reduction& first = reductions.front();
+    if (coloring() && !cancelled())
+        color_cells(*props.front(), first.min, first.max);
+
+    return results(_indicators, request, reductions);
+}
+
+#endif // INDICATORS_TETRAHEDRA_HH
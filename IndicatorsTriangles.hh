@@ -2,6 +2,7 @@
 #define INDICATORS_TRIANGLE_HH 
 
 #include "Indicators.hh"
+#include "IndicatorsSimd.hh"
 
 #include <ObjectTypes/TriangleMesh/TriangleMesh.hh>
 
@@ -9,54 +10,152 @@ class IndicatorsTriangles : public Indicators
 {
 public:
     IndicatorsTriangles(TriMesh& _mesh):
-    Indicators(), mesh_(_mesh)
+    Indicators(), mesh_(_mesh), isa_(indicatorsSimd::detect())
     {
-        mesh_.add_property(face_aspect_ratio_, "Aspect ratio");
-        mesh_.add_property(face_skewness_, "Skewness");
-        mesh_.add_property(face_interpolation_quality_, "Interpolation quality");
-        mesh_.add_property(face_mean_ratio_, "Mean ratio");
-        mesh_.add_property(face_shape_regularity_, "Shape Regularity");
+        add_properties<indicatorsRegistry::Triangle>(mesh_);
     }
 
     virtual ~IndicatorsTriangles()
     {
-        mesh_.remove_property(face_aspect_ratio_);
-        mesh_.remove_property(face_skewness_);
-        mesh_.remove_property(face_interpolation_quality_);
-        mesh_.remove_property(face_mean_ratio_);
-        mesh_.remove_property(face_shape_regularity_);
+        remove_properties(mesh_);
     }
 
-private:
-    struct Triangle
+public:
+    virtual double value(const indicatorsType::indicators& _i, const size_t _f) const override
     {
-        Point v0;
-        Point v1;
-        Point v2;
-    };
+        return face_values(mesh_, _i)[_f];
+    }
 
-public:
-    virtual Result warping() override;
+    virtual std::vector<Result> compute_all(const std::vector<indicatorsType::indicators>& _indicators) override
+    {
+        return compute_list(indicatorsRegistry::All(), _indicators);
+    }
+
+    virtual void select_worst(const Result& _result) override { select_faces(mesh_, _result.worst); }
+
+    virtual bool export_values(const std::string& _path) override
+    {
+        update_snapshot();
+        return export_columns(mesh_, _path);
+    }
 
-    virtual Result aspect_ratio() override;
+    virtual bool load_values(const std::string& _path) override
+    {
+        update_snapshot();
+        return load_columns(mesh_, _path);
+    }
 
-    virtual Result skewness() override;
+    // the indicators Is only, in a loop instantiated for them, e.g. compute<indicatorsRegistry::MeanRatio>()
+    template<class... Is>
+    std::vector<Result> compute()
+    {
+        return compute_list(indicatorsRegistry::List<Is...>(), indicatorsRegistry::ids(indicatorsRegistry::List<Is...>()));
+    }
 
-    virtual Result taper() override;
+    // instruction set of the batched kernels, limited to what the cpu supports
+    void set_isa(const indicatorsSimd::isa& _isa) { isa_ = std::min(_isa, indicatorsSimd::detect()); }
 
-    virtual Result interpolation_quality() override;
+    indicatorsSimd::isa isa() const { return isa_; }
 
-    virtual Result mean_ratio() override;
+    // the batched kernels read the edge lengths from a per edge cache instead of computing them per face, the
+    // same values at the cost of 16 bytes per edge and of an edge index per corner. changing it recomputes
+    // every indicator
+    void set_edge_cache(const bool _cache) { snapshot_.set_edge_cache(_cache); }
 
-    virtual Result shape_regularity() override;
+    bool edge_cache() const { return snapshot_.edge_cache(); }
 
 private:
-    Triangle get_triangle(const TriMesh::FaceHandle& _fh) const;
+    void update_snapshot();
+
+    indicatorsRegistry::Triangle get_triangle(const size_t _f) const;
+
+    // face source of evaluate_triangles(), the faces of a chunk read from the snapshot
+    struct Source
+    {
+        const IndicatorsTriangles& indicators;
+        const Faces& faces;
+
+        bool triangle(const size_t _i, indicatorsRegistry::Triangle& _tr) const
+        {
+            _tr = indicators.get_triangle(faces[_i]);
+            return true;
+        }
+
+        bool cached() const { return indicators.snapshot_.edge_cache(); }
+
+        void edges(const size_t _i, double* _sqr_e, double* _e) const
+        {
+            const unsigned int* edges = indicators.snapshot_.face_edges(faces[_i]);
+            for (size_t e(0); e < 3; ++e)
+            {
+                _sqr_e[e] = indicators.snapshot_.edge_sqr_length(edges[e]);
+                _e[e] = indicators.snapshot_.edge_length(edges[e]);
+            }
+        }
+    };
+
+    // fused traversal of the indicators of the list, the requested ones not in it are undefined
+    template<class... Is>
+    std::vector<Result> compute_list(indicatorsRegistry::List<Is...>, const std::vector<indicatorsType::indicators>&);
 
-    virtual void color_coding(const OpenMesh::FPropHandleT<double>&, const double, const double) override;
+    virtual void color_coding(const indicatorsType::indicators&, const double, const double) override;
 
 private:
     TriMesh& mesh_;
+
+    indicatorsSimd::isa isa_;
 };
 
+//====================================================================================================================//
+template<class... Is>
+std::vector<Indicators::Result> IndicatorsTriangles::compute_list(indicatorsRegistry::List<Is...> _list,
+    const std::vector<indicatorsType::indicators>& _indicators)
+{
+    // a single traversal, the faces are gathered in blocks, the batched kernels evaluate their indicators from
+    // shared edge lengths and area and the other ones are called per face, see evaluate_triangles()
+    const IndicatorsProfile::Run run(profile_);
+
+    bool defined[indicatorsType::n_indicators];
+    indicatorsRegistry::defined<indicatorsRegistry::Triangle>(_list, defined);
+
+    const Request request = this->request(_indicators, defined);
+    const std::vector<indicatorsType::indicators>& active = request.active;
+
+    if (active.empty())
+        return results(_indicators, request, {});
+
+    {
+        const IndicatorsProfile::Timer timer(profile_, IndicatorsProfile::GEOMETRY);
+        update_snapshot();
+    }
+
+    std::vector<FaceValues<TriMesh>> face_values;
+    for (auto i: active)
+    {
+        face_values.push_back(this->face_values(mesh_, i));
+    }
+
+    const indicatorsSimd::Kernel kernel = indicatorsSimd::kernel(isa_);
+
+    auto reductions = evaluate(mesh_, active, [&](const Faces& _faces, Reduction* _reductions)
+    {
+        const Source source = {*this, _faces};
+        evaluate_triangles(_list, source, 0, _faces.n, kernel, request, [&](const size_t _i, const size_t _k, double _value)
+        {
+            const size_t f = _faces[_i];
+
+            _value = face_values[_k].set(f, _value);
+            if (_reductions)
+                _reductions[_k].add(f, _value);
+        });
+    });
+
+    std::vector<Result> results = this->results(_indicators, request, reductions);
+
+    const Reduction& first = reductions.front();
+    color(active.front(), first.min, first.max);
+
+    return results;
+}
+
 #endif // INDICATORS_TRIANGLE_HH
\ No newline at end of file
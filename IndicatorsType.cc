@@ -1,16 +1,42 @@
 #include "IndicatorsType.hh"
+#include "IndicatorsRegistry.hh"
+
+#include <cctype>
 
 std::string indicatorsType::as_s(const indicators& i)
 {
-    switch(i)
+    return indicatorsRegistry::entry(i).name;
+}
+
+std::vector<indicatorsType::indicators> indicatorsType::all()
+{
+    std::vector<indicators> ids;
+    for (const auto& e: indicatorsRegistry::entries())
+    {
+        ids.push_back(e.id);
+    }
+    return ids;
+}
+
+bool indicatorsType::from_s(const std::string& s, indicators& i)
+{
+    auto key = [](std::string k)
     {
-        case WARPING:           return "Warping"; break;
-        case ASPECTRATIO:       return "Aspect ratio"; break;
-        case SKEWNESS:          return "Skewness"; break;
-        case TAPER:             return "Taper"; break;
-        case INTERPOLATIONQUALITY: return "Interpolation quality"; break;
-        case MEANRATIO:         return "Mean ratio"; break;
-        case SHAPEREGULARITY:   return "Shape regularity"; break;
+        for (auto& c: k)
+        {
+            c = (c == '_') ? ' ' : std::tolower(static_cast<unsigned char>(c));
+        }
+        return k;
+    };
+
+    for (auto candidate: all())
+    {
+        if (key(as_s(candidate)) == key(s))
+        {
+            i = candidate;
+            return true;
+        }
     }
-    return "";
-}
\ No newline at end of file
+
+    return false;
+}
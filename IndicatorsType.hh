@@ -1,13 +1,23 @@
 #ifndef INDICATORSTYPE_HH
 #define INDICATORSTYPE_HH
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace indicatorsType
 {
     enum indicators {WARPING, ASPECTRATIO, SKEWNESS, TAPER, INTERPOLATIONQUALITY, MEANRATIO, SHAPEREGULARITY};
 
+    // size of the tables indexed by indicator, the indicators themselves are listed in IndicatorsRegistry.hh
+    static const size_t n_indicators = SHAPEREGULARITY + 1;
+
     std::string as_s(const indicators& i);
+
+    // inverse of as_s, case insensitive and with '_' accepted for spaces
+    bool from_s(const std::string& s, indicators& i);
+
+    std::vector<indicators> all();
 }
 
 #endif //INDICATORSTYPE_HH
\ No newline at end of file
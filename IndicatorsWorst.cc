@@ -0,0 +1,102 @@
+#include "IndicatorsWorst.hh"
+
+#include <algorithm>
+
+IndicatorsWorst::IndicatorsWorst(const size_t _k, const double _threshold, const bool _higher_is_worse):
+k_(_k), threshold_(_threshold), higher_is_worse_(_higher_is_worse), threshold_key_(std::numeric_limits<double>::infinity()),
+bounded_(false), bound_{0, 0.0}, bound_key_(0.0), dropped_(false), complete_(true)
+{
+    if (!std::isnan(_threshold))
+        threshold_key_ = key(_threshold);
+}
+
+//====================================================================================================================//
+void IndicatorsWorst::insert(const Face& _face)
+{
+    auto worse = [this](const Face& _a, const Face& _b) { return this->worse(_a, _b); };
+
+    if (bounded_ && !worse(_face, bound_))
+    {
+        dropped_ = true;
+        return;
+    }
+
+    if (heap_.size() < k_)
+    {
+        heap_.push_back(_face);
+        std::push_heap(heap_.begin(), heap_.end(), worse);
+    }
+      else
+    {
+        std::pop_heap(heap_.begin(), heap_.end(), worse);
+        heap_.back() = _face;
+        std::push_heap(heap_.begin(), heap_.end(), worse);
+        dropped_ = true;
+    }
+
+    // a full heap only takes faces worse than its front, which is worse than any bound given to limit()
+    if (heap_.size() == k_)
+        bound(heap_.front());
+}
+
+void IndicatorsWorst::merge(const IndicatorsWorst& _w)
+{
+    dropped_ = dropped_ || _w.dropped_;
+    complete_ = complete_ && _w.complete_;
+
+    for (const Face& face: _w.heap_)
+    {
+        insert(face);
+    }
+}
+
+void IndicatorsWorst::limit(const IndicatorsWorst& _w)
+{
+    if (!_w.k_ || _w.heap_.size() < _w.k_)
+        return;
+
+    if (!bounded_ || worse(_w.heap_.front(), bound_))
+        bound(_w.heap_.front());
+}
+
+void IndicatorsWorst::remove(const std::vector<unsigned int>& _sorted)
+{
+    const size_t n = heap_.size();
+
+    heap_.erase(std::remove_if(heap_.begin(), heap_.end(), [&](const Face& _face)
+    {
+        return std::binary_search(_sorted.begin(), _sorted.end(), _face.face);
+    }), heap_.end());
+
+    if (heap_.size() == n)
+        return;
+
+    std::make_heap(heap_.begin(), heap_.end(), [this](const Face& _a, const Face& _b) { return worse(_a, _b); });
+
+    // the heap is not full anymore
+    bounded_ = false;
+
+    if (dropped_)
+        complete_ = false;
+}
+
+bool IndicatorsWorst::same_query(const IndicatorsWorst& _w) const
+{
+    const bool same_threshold = std::isnan(threshold_) ? std::isnan(_w.threshold_) : threshold_ == _w.threshold_;
+    return k_ == _w.k_ && same_threshold && higher_is_worse_ == _w.higher_is_worse_;
+}
+
+void IndicatorsWorst::clear()
+{
+    heap_.clear();
+    bounded_ = false;
+    dropped_ = false;
+    complete_ = true;
+}
+
+std::vector<IndicatorsWorst::Face> IndicatorsWorst::faces() const
+{
+    std::vector<Face> faces(heap_);
+    std::sort(faces.begin(), faces.end(), [this](const Face& _a, const Face& _b) { return worse(_a, _b); });
+    return faces;
+}
@@ -0,0 +1,127 @@
+#ifndef INDICATORS_WORST_HH
+#define INDICATORS_WORST_HH
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// the worst faces of an indicator, collected in the same loop as min/max/average: the k lowest values below a
+// threshold, or the highest above it for the indicators where higher is worse. a bounded heap of at most k faces,
+// so the selection never sorts the values of the mesh. NaN values are worse than any other, ties are broken by the
+// face index, the selection does not depend on the order in which the faces are added or merged
+class IndicatorsWorst
+{
+public:
+    struct Face
+    {
+        unsigned int face;
+        double value;
+    };
+
+    // keeps no face
+    IndicatorsWorst(): k_(0), threshold_(std::numeric_limits<double>::quiet_NaN()), higher_is_worse_(false),
+    threshold_key_(std::numeric_limits<double>::infinity()), bounded_(false), bound_{0, 0.0}, bound_key_(0.0),
+    dropped_(false), complete_(true) {}
+
+    // at most _k faces, those worse than _threshold when it is not NaN
+    IndicatorsWorst(const size_t _k, const double _threshold, const bool _higher_is_worse);
+
+    bool enabled() const { return k_ > 0; }
+
+    void add(const unsigned int _face, const double _value)
+    {
+        if (!k_)
+            return;
+
+        const double key = this->key(_value);
+        if (!(key < threshold_key_))
+            return;
+
+        // most faces are rejected here, against the least bad kept face once the selection is full
+        if (bounded_ && !(key < bound_key_ || (key == bound_key_ && _face < bound_.face)))
+        {
+            dropped_ = true;
+            return;
+        }
+
+        insert(Face{_face, _value});
+    }
+
+    void merge(const IndicatorsWorst&);
+
+    // once _w is full, the faces that are not worse than all of its faces are left out, as they would be when
+    // merged into it. a chunk limited by the running selection skips most of its faces after the first chunks
+    void limit(const IndicatorsWorst& _w);
+
+    // drops the faces of _sorted, before they are added again with their new values. when one of them was kept
+    // and faces have been left out for the bound, the ones that would replace it are unknown and the selection
+    // is not complete() anymore
+    void remove(const std::vector<unsigned int>& _sorted);
+
+    // false when the faces have to be collected again
+    bool complete() const { return complete_; }
+
+    // same k, threshold and direction, the faces are not compared
+    bool same_query(const IndicatorsWorst&) const;
+
+    // keeps the query
+    void clear();
+
+    size_t size() const { return heap_.size(); }
+
+    size_t k() const { return k_; }
+
+    double threshold() const { return threshold_; }
+
+    bool higher_is_worse() const { return higher_is_worse_; }
+
+    // the kept faces, worst first
+    std::vector<Face> faces() const;
+
+private:
+    // ascending with the badness, NaN first
+    double key(const double _value) const
+    {
+        if (std::isnan(_value))
+            return -std::numeric_limits<double>::infinity();
+
+        return higher_is_worse_ ? -_value : _value;
+    }
+
+    bool worse(const Face& _a, const Face& _b) const
+    {
+        const double a = key(_a.value), b = key(_b.value);
+        return a < b || (a == b && _a.face < _b.face);
+    }
+
+    void insert(const Face&);
+
+    void bound(const Face& _face)
+    {
+        bounded_ = true;
+        bound_ = _face;
+        bound_key_ = key(_face.value);
+    }
+
+private:
+    size_t k_;
+    double threshold_;
+    bool higher_is_worse_;
+    double threshold_key_;
+
+    // a face has to be worse than bound_ to be kept, the least bad kept face when the heap is full or the one of
+    // the selection given to limit()
+    bool bounded_;
+    Face bound_;
+    double bound_key_;
+
+    // heap on worse(), the front is the least bad of the kept faces
+    std::vector<Face> heap_;
+
+    // a face was left out for the bound at some point
+    bool dropped_;
+    bool complete_;
+};
+
+#endif // INDICATORS_WORST_HH
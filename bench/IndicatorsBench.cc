@@ -0,0 +1,387 @@
+// throughput of every indicator on synthetic meshes, one JSON line per measurement on stdout
+//
+//   IndicatorsBench [--sizes 1000,100000,...] [--meshes name,...] [--threads N] [--repeat N]
+//                   [--precision double|single] [--edge-cache on|off] [--accuracy TOLERANCE]
+//
+// meshes: tri_regular, tri_jittered, tri_degenerate, quad, mixed, ngon. the sizes are face counts,
+// the generated meshes have approximately that many faces. every measurement runs a fresh Indicators object,
+// so nothing is reused from a previous evaluation, and includes the color coding of the faces. the time is the
+// best of the repetitions, the peak memory is the one of the process so far and the allocations those of one
+// evaluation, as counted by its IndicatorsProfile. --edge-cache only applies to the triangle meshes
+//
+// --accuracy measures nothing, it compares the single precision values to the double ones on every mesh and
+// exits with 1 when a face deviates by more than TOLERANCE
+
+#include "../IndicatorsTriangles.hh"
+#include "../IndicatorsPolygons.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+    size_t peak_memory()
+    {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.PeakWorkingSetSize;
+        return 0;
+#else
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+        return usage.ru_maxrss;
+#else
+        return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+    }
+
+    //================================================================================================================//
+    // (n+1)^2 grid vertices in the unit square, moved by up to _jitter cells, every _collapse-th row is put on the
+    // previous one so that its faces have no area
+    template<class MeshT>
+    std::vector<typename MeshT::VertexHandle> grid_vertices(MeshT& _mesh, const size_t _n, const double _jitter,
+        const size_t _collapse, std::mt19937& _mt)
+    {
+        std::uniform_real_distribution<double> offset(-_jitter, _jitter);
+        std::vector<typename MeshT::VertexHandle> vertices;
+        vertices.reserve((_n + 1) * (_n + 1));
+
+        const double h = 1.0 / _n;
+        for (size_t j(0); j <= _n; ++j)
+        {
+            const size_t row = (_collapse && j % _collapse == 0 && j > 0) ? j - 1 : j;
+            for (size_t i(0); i <= _n; ++i)
+            {
+                const double dx = _jitter > 0 ? offset(_mt) * h : 0.0;
+                const double dy = _jitter > 0 ? offset(_mt) * h : 0.0;
+                vertices.push_back(_mesh.add_vertex(typename MeshT::Point(i * h + dx, row * h + dy, 0.0)));
+            }
+        }
+
+        return vertices;
+    }
+
+    void triangles(TriMesh& _mesh, const size_t _faces, const double _jitter, const size_t _collapse)
+    {
+        std::mt19937 mt(1);
+        const size_t n = std::max<size_t>(1, std::lround(std::sqrt(_faces / 2.0)));
+        auto v = grid_vertices(_mesh, n, _jitter, _collapse, mt);
+
+        for (size_t j(0); j < n; ++j)
+        {
+            for (size_t i(0); i < n; ++i)
+            {
+                const size_t a = j * (n + 1) + i;
+                _mesh.add_face(v[a], v[a + 1], v[a + n + 2]);
+                _mesh.add_face(v[a], v[a + n + 2], v[a + n + 1]);
+            }
+        }
+    }
+
+    // quads, every other one split in two triangles when _mixed
+    void quads(PolyMesh& _mesh, const size_t _faces, const bool _mixed)
+    {
+        std::mt19937 mt(2);
+        const size_t n = std::max<size_t>(1, std::lround(std::sqrt(_mixed ? _faces / 1.5 : double(_faces))));
+        auto v = grid_vertices(_mesh, n, 0.2, 0, mt);
+
+        for (size_t j(0); j < n; ++j)
+        {
+            for (size_t i(0); i < n; ++i)
+            {
+                const size_t a = j * (n + 1) + i;
+                if (_mixed && (i + j) % 2)
+                {
+                    _mesh.add_face(std::vector<PolyMesh::VertexHandle>{v[a], v[a + 1], v[a + n + 2]});
+                    _mesh.add_face(std::vector<PolyMesh::VertexHandle>{v[a], v[a + n + 2], v[a + n + 1]});
+                }
+                  else
+                {
+                    _mesh.add_face(std::vector<PolyMesh::VertexHandle>{v[a], v[a + 1], v[a + n + 2], v[a + n + 1]});
+                }
+            }
+        }
+    }
+
+    // separate slightly irregular, slightly non planar polygons of 8 to 32 vertices
+    void ngons(PolyMesh& _mesh, const size_t _faces)
+    {
+        std::mt19937 mt(3);
+        std::uniform_int_distribution<int> valence(8, 32);
+        std::uniform_real_distribution<double> noise(-0.05, 0.05);
+
+        const size_t n = std::max<size_t>(1, std::lround(std::sqrt(double(_faces))));
+        std::vector<PolyMesh::VertexHandle> face;
+
+        for (size_t j(0); j < n; ++j)
+        {
+            for (size_t i(0); i < n; ++i)
+            {
+                const int k = valence(mt);
+                face.clear();
+                for (int c(0); c < k; ++c)
+                {
+                    const double a = 2.0 * M_PI * c / k;
+                    const double r = 0.45 * (1.0 + noise(mt));
+                    face.push_back(_mesh.add_vertex(PolyMesh::Point(i + r * std::cos(a), j + r * std::sin(a), noise(mt))));
+                }
+                _mesh.add_face(face);
+            }
+        }
+    }
+
+    //================================================================================================================//
+    struct Options
+    {
+        std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};
+        std::vector<std::string> meshes = {"tri_regular", "tri_jittered", "tri_degenerate", "quad", "mixed", "ngon"};
+        unsigned int threads = 0;
+        unsigned int repeat = 3;
+        bool single_precision = false;
+        bool edge_cache = false;
+        bool accuracy = false;
+        double tolerance = 0.0;
+    };
+
+    std::vector<std::string> split(const std::string& _list)
+    {
+        std::vector<std::string> items;
+        std::stringstream s(_list);
+        std::string item;
+        while (std::getline(s, item, ','))
+        {
+            items.push_back(item);
+        }
+        return items;
+    }
+
+    bool parse(int _argc, char** _argv, Options& _options)
+    {
+        for (int a(1); a + 1 < _argc; a += 2)
+        {
+            const std::string arg(_argv[a]);
+
+            if (arg == "--sizes")
+            {
+                _options.sizes.clear();
+                for (auto& s: split(_argv[a + 1]))
+                {
+                    _options.sizes.push_back(std::strtoull(s.c_str(), nullptr, 10));
+                }
+            }
+              else if (arg == "--meshes")
+                _options.meshes = split(_argv[a + 1]);
+              else if (arg == "--threads")
+                _options.threads = std::strtoul(_argv[a + 1], nullptr, 10);
+              else if (arg == "--repeat")
+                _options.repeat = std::max(1ul, std::strtoul(_argv[a + 1], nullptr, 10));
+              else if (arg == "--precision" && (std::string(_argv[a + 1]) == "single" || std::string(_argv[a + 1]) == "double"))
+                _options.single_precision = std::string(_argv[a + 1]) == "single";
+              else if (arg == "--edge-cache" && (std::string(_argv[a + 1]) == "on" || std::string(_argv[a + 1]) == "off"))
+                _options.edge_cache = std::string(_argv[a + 1]) == "on";
+              else if (arg == "--accuracy")
+              {
+                _options.accuracy = true;
+                _options.tolerance = std::strtod(_argv[a + 1], nullptr);
+              }
+              else
+                return false;
+        }
+
+        return _argc % 2 == 1;
+    }
+
+    void configure(IndicatorsTriangles& _indicators, const Options& _options)
+    {
+        _indicators.set_edge_cache(_options.edge_cache);
+    }
+
+    void configure(IndicatorsPolygons&, const Options&) {}
+
+    // times compute_all(_indicators) on a new IndicatorsT per repetition, one line per indicator set
+    template<class IndicatorsT, class MeshT>
+    void measure(const std::string& _name, MeshT& _mesh, const std::string& _label,
+        const std::vector<indicatorsType::indicators>& _indicators, const Options& _options)
+    {
+        double best = std::numeric_limits<double>::max();
+        bool defined = false;
+        size_t allocations = 0;
+
+        for (unsigned int r(0); r < _options.repeat; ++r)
+        {
+            IndicatorsT indicators(_mesh);
+            indicators.set_num_threads(_options.threads);
+            indicators.set_single_precision(_options.single_precision);
+            configure(indicators, _options);
+
+            const auto start = std::chrono::steady_clock::now();
+            const auto results = indicators.compute_all(_indicators);
+            const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+
+            best = std::min(best, seconds.count());
+            allocations = indicators.profile().report().counters[IndicatorsProfile::ALLOCATIONS];
+            defined = std::any_of(results.begin(), results.end(),
+                [](const Indicators::Result& _r) { return _r.min >= 0; });
+        }
+
+        if (!defined)
+            return;
+
+        const double faces = double(_mesh.n_faces());
+        std::printf("{\"mesh\":\"%s\",\"faces\":%zu,\"indicator\":\"%s\",\"threads\":%u,\"precision\":\"%s\","
+                    "\"edge_cache\":%s,"
+                    "\"seconds\":%.9g,\"faces_per_second\":%.6g,\"ns_per_face\":%.6g,\"peak_memory_bytes\":%zu,"
+                    "\"allocations\":%zu}\n",
+            _name.c_str(), size_t(_mesh.n_faces()), _label.c_str(), _options.threads,
+            _options.single_precision ? "single" : "double", _options.edge_cache ? "true" : "false", best, faces / best,
+            best * 1e9 / faces, peak_memory(), allocations);
+        std::fflush(stdout);
+    }
+
+    template<class IndicatorsT, class MeshT>
+    void measure_all(const std::string& _name, MeshT& _mesh, const Options& _options)
+    {
+        for (auto i: indicatorsType::all())
+        {
+            measure<IndicatorsT>(_name, _mesh, indicatorsType::as_s(i), {i}, _options);
+        }
+
+        measure<IndicatorsT>(_name, _mesh, "All", indicatorsType::all(), _options);
+    }
+
+    // largest deviation of the single precision values from the double ones, over the faces and on the
+    // results, one line per indicator. false when a face deviates by more than the tolerance
+    template<class IndicatorsT, class MeshT>
+    bool compare_precision(const std::string& _name, MeshT& _mesh, const Options& _options)
+    {
+        bool within = true;
+
+        for (auto i: indicatorsType::all())
+        {
+            std::vector<double> reference(_mesh.n_faces());
+            Indicators::Result exact;
+            {
+                IndicatorsT indicators(_mesh);
+                indicators.set_num_threads(_options.threads);
+                exact = indicators.compute_all({i}).front();
+                if (exact.min < 0)
+                    continue;
+
+                for (size_t f(0); f < reference.size(); ++f)
+                {
+                    reference[f] = indicators.value(i, f);
+                }
+            }
+
+            IndicatorsT indicators(_mesh);
+            indicators.set_num_threads(_options.threads);
+            indicators.set_single_precision(true);
+            const Indicators::Result single = indicators.compute_all({i}).front();
+
+            double deviation(0.0);
+            for (size_t f(0); f < reference.size(); ++f)
+            {
+                const double value = indicators.value(i, f);
+                if (std::isnan(value) != std::isnan(reference[f]))
+                    deviation = std::numeric_limits<double>::infinity();
+                  else if (!std::isnan(value))
+                    deviation = std::max(deviation, std::abs(value - reference[f]));
+            }
+
+            std::printf("{\"mesh\":\"%s\",\"faces\":%zu,\"indicator\":\"%s\",\"max_face_deviation\":%.6g,"
+                        "\"min_deviation\":%.6g,\"max_deviation\":%.6g,\"average_deviation\":%.6g}\n",
+                _name.c_str(), size_t(_mesh.n_faces()), indicatorsType::as_s(i).c_str(), deviation,
+                std::abs(single.min - exact.min), std::abs(single.max - exact.max), std::abs(single.average - exact.average));
+            std::fflush(stdout);
+
+            within = within && deviation <= _options.tolerance;
+        }
+
+        return within;
+    }
+
+    template<class IndicatorsT, class MeshT>
+    bool run(const std::string& _name, MeshT& _mesh, const Options& _options)
+    {
+        if (_options.accuracy)
+            return compare_precision<IndicatorsT>(_name, _mesh, _options);
+
+        measure_all<IndicatorsT>(_name, _mesh, _options);
+        return true;
+    }
+}
+
+//====================================================================================================================//
+int main(int _argc, char** _argv)
+{
+    Options options;
+    if (!parse(_argc, _argv, options))
+    {
+        std::cerr << "usage: " << _argv[0] << " [--sizes 1000,100000,...] [--meshes name,...] [--threads N] [--repeat N]\n"
+                  << "       [--precision double|single] [--edge-cache on|off] [--accuracy TOLERANCE]\n"
+                  << "  meshes: tri_regular, tri_jittered, tri_degenerate, quad, mixed, ngon\n"
+                  << "  --accuracy compares single to double precision and fails past the tolerance\n";
+        return 2;
+    }
+
+    bool within = true;
+
+    for (auto size: options.sizes)
+    {
+        for (auto& name: options.meshes)
+        {
+            if (name.compare(0, 4, "tri_") == 0)
+            {
+                TriMesh mesh;
+                mesh.request_face_colors();
+
+                if (name == "tri_regular")
+                    triangles(mesh, size, 0.0, 0);
+                  else if (name == "tri_jittered")
+                    triangles(mesh, size, 0.3, 0);
+                  else if (name == "tri_degenerate")
+                    triangles(mesh, size, 0.3, 7);
+                  else
+                    continue;
+
+                within = run<IndicatorsTriangles>(name, mesh, options) && within;
+            }
+              else
+            {
+                PolyMesh mesh;
+                mesh.request_face_colors();
+
+                if (name == "quad")
+                    quads(mesh, size, false);
+                  else if (name == "mixed")
+                    quads(mesh, size, true);
+                  else if (name == "ngon")
+                    ngons(mesh, size);
+                  else
+                    continue;
+
+                within = run<IndicatorsPolygons>(name, mesh, options) && within;
+            }
+        }
+    }
+
+    return within ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+// replaces the global operator new so that IndicatorsProfile counts the heap allocations of the evaluations, an
+// increment of a thread local counter per allocation. linked into the executables only, never into a library or
+// the plugin, whose allocator belongs to its host
+
+#include "../IndicatorsProfile.hh"
+
+#include <cstdlib>
+#include <new>
+
+void* operator new(std::size_t _size)
+{
+    IndicatorsProfile::count_allocation();
+
+    if (void* p = std::malloc(_size ? _size : 1))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t _size)
+{
+    return operator new(_size);
+}
+
+void operator delete(void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete[](void* _p) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete(void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+void operator delete[](void* _p, std::size_t) noexcept
+{
+    std::free(_p);
+}
+
+namespace
+{
+    const bool counting = (IndicatorsProfile::set_counting_allocations(true), true);
+}
@@ -0,0 +1,427 @@
+// headless evaluation of the quality indicators over mesh files, without the OpenFlipper GUI
+//
+//   IndicatorsCli [--json] [--jobs N] [--threads N] [--single] [--convert] [--export] [--profile]
+//                 [--indicators name,...] file...
+//
+// files are read with OpenMesh IO (OFF/OBJ/PLY/...), "-" reads further file names from stdin, one per line.
+// files ending in .imesh are streamed from the disk by IndicatorsStream, their face values written next to them
+// as <file>.values, --convert writes the other ones as <file>.imesh instead of evaluating them. --export writes
+// the face values of the loaded meshes as <file>.columns, both are IndicatorsColumns files. --profile adds the
+// IndicatorsProfile of every evaluation, its heap allocations included, to the JSON objects or as a line to stderr.
+// several files are evaluated at once, while a job computes the next ones are already loading, and one line
+// per mesh is written to stdout as soon as it is done, so the output order is the completion order
+
+#include <OpenMesh/Core/IO/MeshIO.hh>
+
+#include "../IndicatorsTriangles.hh"
+#include "../IndicatorsPolygons.hh"
+#include "../IndicatorsStream.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Options
+    {
+        bool json = false;
+        unsigned int jobs = 0;
+        unsigned int threads = 0;
+        bool single_precision = false;
+        bool convert = false;
+        bool export_values = false;
+        bool profile = false;
+        std::vector<indicatorsType::indicators> indicators = indicatorsType::all();
+        std::vector<std::string> files;
+    };
+
+    void usage(const char* _name)
+    {
+        std::cerr << "usage: " << _name << " [--json] [--jobs N] [--threads N] [--single] [--convert] [--export] [--profile] [--indicators name,...] file...\n"
+                  << "  --json        one JSON object per mesh, with the 1%, 50% and 99% quantiles, instead of CSV rows\n"
+                  << "  --jobs N      meshes evaluated at once, default one per core\n"
+                  << "  --threads N   threads per mesh, default cores / jobs\n"
+                  << "  --single      face values and coordinates stored as float, less memory per mesh\n"
+                  << "  --convert     writes every mesh as <file>.imesh, evaluated from the disk in bounded memory\n"
+                  << "  --export      writes the face values of every mesh as <file>.columns\n"
+                  << "  --profile     time of the phases and counters of every evaluation\n"
+                  << "  --indicators  comma separated, e.g. aspect_ratio,skewness, default all\n"
+                  << "  -             read the file names from stdin\n";
+    }
+
+    bool parse(int _argc, char** _argv, Options& _options)
+    {
+        for (int a(1); a < _argc; ++a)
+        {
+            const std::string arg(_argv[a]);
+
+            if (arg == "--json")
+            {
+                _options.json = true;
+            }
+              else if (arg == "--single")
+            {
+                _options.single_precision = true;
+            }
+              else if (arg == "--convert")
+            {
+                _options.convert = true;
+            }
+              else if (arg == "--export")
+            {
+                _options.export_values = true;
+            }
+              else if (arg == "--profile")
+            {
+                _options.profile = true;
+            }
+              else if ((arg == "--jobs" || arg == "--threads") && a + 1 < _argc)
+            {
+                const unsigned int n = std::strtoul(_argv[++a], nullptr, 10);
+                (arg == "--jobs" ? _options.jobs : _options.threads) = n;
+            }
+              else if (arg == "--indicators" && a + 1 < _argc)
+            {
+                _options.indicators.clear();
+
+                std::stringstream list(_argv[++a]);
+                std::string name;
+                while (std::getline(list, name, ','))
+                {
+                    indicatorsType::indicators i;
+                    if (!indicatorsType::from_s(name, i))
+                    {
+                        std::cerr << "unknown indicator: " << name << "\n";
+                        return false;
+                    }
+                    _options.indicators.push_back(i);
+                }
+            }
+              else if (arg == "-")
+            {
+                std::string file;
+                while (std::getline(std::cin, file))
+                {
+                    if (!file.empty())
+                        _options.files.push_back(file);
+                }
+            }
+              else if (!arg.empty() && arg[0] == '-')
+            {
+                return false;
+            }
+              else
+            {
+                _options.files.push_back(arg);
+            }
+        }
+
+        return !_options.files.empty() && !_options.indicators.empty();
+    }
+
+    //================================================================================================================//
+    std::string quoted_csv(const std::string& _s)
+    {
+        if (_s.find_first_of(",\"\n") == std::string::npos)
+            return _s;
+
+        std::string q("\"");
+        for (auto c: _s)
+        {
+            if (c == '"')
+                q += '"';
+            q += c;
+        }
+        return q + "\"";
+    }
+
+    std::string quoted_json(const std::string& _s)
+    {
+        std::string q("\"");
+        for (auto c: _s)
+        {
+            switch (c)
+            {
+                case '"':  q += "\\\""; break;
+                case '\\': q += "\\\\"; break;
+                case '\n': q += "\\n"; break;
+                case '\t': q += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        char e[8];
+                        std::snprintf(e, sizeof(e), "\\u%04x", c);
+                        q += e;
+                    }
+                      else
+                    {
+                        q += c;
+                    }
+            }
+        }
+        return q + "\"";
+    }
+
+    std::string number(const double _value)
+    {
+        char s[32];
+        std::snprintf(s, sizeof(s), "%.17g", _value);
+        return s;
+    }
+
+    // CSV: file,faces,indicator,min,max,average, one row per defined indicator
+    std::string csv(const std::string& _file, const size_t _n_faces,
+        const std::vector<indicatorsType::indicators>& _indicators, const std::vector<Indicators::Result>& _results)
+    {
+        std::string out;
+        for (size_t k(0); k < _results.size(); ++k)
+        {
+            const Indicators::Result& r = _results[k];
+            if (r.min < 0)
+                continue;
+
+            out += quoted_csv(_file) + "," + std::to_string(_n_faces) + "," + indicatorsType::as_s(_indicators[k])
+                + "," + number(r.min) + "," + number(r.max) + "," + number(r.average) + "\n";
+        }
+        return out;
+    }
+
+    std::string json(const std::string& _file, const size_t _n_faces,
+        const std::vector<indicatorsType::indicators>& _indicators, const std::vector<Indicators::Result>& _results,
+        const IndicatorsProfile::Report* _profile)
+    {
+        std::string out = "{\"file\":" + quoted_json(_file) + ",\"faces\":" + std::to_string(_n_faces) + ",\"results\":{";
+
+        bool first(true);
+        for (size_t k(0); k < _results.size(); ++k)
+        {
+            const Indicators::Result& r = _results[k];
+            if (r.min < 0)
+                continue;
+
+            out += std::string(first ? "" : ",") + quoted_json(indicatorsType::as_s(_indicators[k]))
+                + ":{\"min\":" + number(r.min) + ",\"max\":" + number(r.max) + ",\"average\":" + number(r.average)
+                + ",\"p01\":" + number(r.distribution.quantile(0.01)) + ",\"p50\":" + number(r.distribution.quantile(0.5))
+                + ",\"p99\":" + number(r.distribution.quantile(0.99)) + "}";
+            first = false;
+        }
+        out += "}";
+
+        if (_profile)
+        {
+            out += ",\"profile\":{";
+            first = true;
+            for (const auto& entry: _profile->entries())
+            {
+                out += std::string(first ? "" : ",") + quoted_json(entry.first) + ":" + number(entry.second);
+                first = false;
+            }
+            out += "}";
+        }
+
+        return out + "}\n";
+    }
+
+    //================================================================================================================//
+    bool all_triangles(const PolyMesh& _mesh)
+    {
+        for (auto fh: _mesh.faces())
+        {
+            if (_mesh.valence(fh) != 3)
+                return false;
+        }
+        return true;
+    }
+
+    void to_triangles(const PolyMesh& _poly, TriMesh& _tri)
+    {
+        for (auto vh: _poly.vertices())
+        {
+            _tri.add_vertex(_poly.point(vh));
+        }
+
+        for (auto fh: _poly.faces())
+        {
+            std::vector<TriMesh::VertexHandle> face;
+            for (auto vh_iter = _poly.cfv_iter(fh); vh_iter.is_valid(); ++vh_iter)
+            {
+                face.push_back(_tri.vertex_handle((*vh_iter).idx()));
+            }
+            _tri.add_face(face);
+        }
+    }
+
+    bool streamed(const std::string& _file)
+    {
+        const std::string extension(".imesh");
+        return _file.size() > extension.size() && _file.compare(_file.size() - extension.size(), extension.size(), extension) == 0;
+    }
+
+    // _profile is null when the mesh was not evaluated
+    std::string output(const std::string& _file, const size_t _n_faces, const Options& _options,
+        const std::vector<Indicators::Result>& _results, const IndicatorsProfile::Report* _profile)
+    {
+        if (!_options.profile)
+            _profile = nullptr;
+
+        if (_options.json)
+            return json(_file, _n_faces, _options.indicators, _results, _profile);
+
+        if (_profile)
+            std::cerr << _file + ": " + _profile->text() + "\n";
+
+        const std::string rows = csv(_file, _n_faces, _options.indicators, _results);
+        return rows.empty() ? quoted_csv(_file) + "," + std::to_string(_n_faces) + ",,,,\n" : rows;
+    }
+
+    // evaluates a mesh file block by block, without loading it
+    std::string stream(const std::string& _file, const Options& _options, const unsigned int _threads)
+    {
+        IndicatorsStream indicators;
+        if (!indicators.open(_file, _file + ".values"))
+            return std::string();
+
+        indicators.set_num_threads(_threads);
+        const std::vector<Indicators::Result> results = indicators.compute_all(_options.indicators);
+        if (indicators.failed())
+            return std::string();
+
+        const IndicatorsProfile::Report profile = indicators.profile().report();
+        return output(_file, indicators.n_faces(), _options, results, &profile);
+    }
+
+    // loads and evaluates one file, returns the output line or an empty string when it cannot be read
+    std::string evaluate(const std::string& _file, const Options& _options, const unsigned int _threads)
+    {
+        if (streamed(_file))
+            return stream(_file, _options, _threads);
+
+        PolyMesh poly;
+        if (!OpenMesh::IO::read_mesh(poly, _file))
+            return std::string();
+
+        if (_options.convert)
+        {
+            const std::string converted = _file + ".imesh";
+            if (!IndicatorsStream::write(poly, converted))
+                return std::string();
+
+            return _options.json ? "{\"file\":" + quoted_json(_file) + ",\"converted\":" + quoted_json(converted) + "}\n"
+                : quoted_csv(converted) + "\n";
+        }
+
+        const size_t n_faces = poly.n_faces();
+        std::vector<Indicators::Result> results;
+        IndicatorsProfile::Report profile;
+
+        if (n_faces == 0)
+        {
+            results.resize(_options.indicators.size());
+            for (auto& r: results)
+            {
+                r.min = -1;
+            }
+
+            return output(_file, n_faces, _options, results, nullptr);
+        }
+          else if (all_triangles(poly))
+        {
+            // triangle meshes go through the batched triangle kernels
+            TriMesh tri;
+            to_triangles(poly, tri);
+            poly.clear();
+
+            tri.request_face_colors();
+            IndicatorsTriangles indicators(tri);
+            indicators.set_num_threads(_threads);
+            indicators.set_single_precision(_options.single_precision);
+            results = indicators.compute_all(_options.indicators);
+            if (_options.export_values && !indicators.export_values(_file + ".columns"))
+                return std::string();
+            profile = indicators.profile().report();
+        }
+          else
+        {
+            poly.request_face_colors();
+            IndicatorsPolygons indicators(poly);
+            indicators.set_num_threads(_threads);
+            indicators.set_single_precision(_options.single_precision);
+            results = indicators.compute_all(_options.indicators);
+            if (_options.export_values && !indicators.export_values(_file + ".columns"))
+                return std::string();
+            profile = indicators.profile().report();
+        }
+
+        return output(_file, n_faces, _options, results, &profile);
+    }
+}
+
+//====================================================================================================================//
+int main(int _argc, char** _argv)
+{
+    Options options;
+    if (!parse(_argc, _argv, options))
+    {
+        usage(_argv[0]);
+        return 2;
+    }
+
+    const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t jobs = std::min<size_t>(options.jobs ? options.jobs : cores, options.files.size());
+    const unsigned int threads = options.threads ? options.threads : std::max<unsigned int>(1, cores / jobs);
+
+    if (!options.json && !options.convert)
+        std::cout << "file,faces,indicator,min,max,average\n" << std::flush;
+
+    // every job loads its next file as soon as it is done with the previous one, so reading overlaps with the
+    // evaluation running in the other jobs
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> failed(0);
+    std::mutex output;
+
+    auto job = [&]()
+    {
+        for (size_t f = next++; f < options.files.size(); f = next++)
+        {
+            const std::string& file = options.files[f];
+            const std::string line = evaluate(file, options, threads);
+
+            std::lock_guard<std::mutex> lock(output);
+            if (line.empty())
+            {
+                failed++;
+                std::cerr << "cannot read " << file << "\n";
+                if (options.json)
+                    std::cout << "{\"file\":" << quoted_json(file) << ",\"error\":\"cannot read\"}\n";
+            }
+              else
+            {
+                std::cout << line;
+            }
+            std::cout.flush();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t j(1); j < jobs; ++j)
+    {
+        workers.emplace_back(job);
+    }
+
+    job();
+
+    for (auto& w: workers)
+    {
+        w.join();
+    }
+
+    return failed ? 1 : 0;
+}
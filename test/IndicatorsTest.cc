@@ -0,0 +1,1009 @@
+// checks of the indicators on generated triangles and meshes, one line per check on stdout
+//
+//   IndicatorsTest
+//
+// kernels: the vector triangle kernels of every instruction set the cpu supports against the scalar one, within
+// the ulp bounds of IndicatorsSimd.hh on random, degenerated and subnormal triangles
+//
+// skewness: the skewness of triangles and polygons, without acos and sin, against the sines of their smallest and
+// largest angles from atan2 in long double, on random triangles and on slivers, needles and quads with a corner
+// close to flat
+//
+// inscribed: the radius of IndicatorsInscribed against the exact one of regular 3- to 12-gons, rectangles,
+// trapezoids and polygons with collinear corners, rotated out of the xy plane, and below it on an L-shape
+//
+// distribution: the quantiles of IndicatorsDistribution within 0.4% of the sorted values, its histogram counts,
+// and merge(), subtract() and remove() giving the distribution of the values added directly
+//
+// worst: the worst faces of IndicatorsWorst, added in chunks limited by the running selection or in any order,
+// against the sorted values, and remove() keeping a selection complete only when no face was left out
+//
+// stream: a mesh written as a mesh file and streamed by IndicatorsStream in several blocks has the results and
+// the face values of the mesh in memory, to the bit, and its values file loaded by load_values() into the mesh in
+// memory gives them again. the files are written to the working directory and removed
+//
+// incremental: after moving random vertices, the incremental evaluation of the faces around them has the results,
+// distributions, worst faces and face values of a full evaluation by a new instance, to the bit
+//
+// precision: the face values and results of the single precision mode deviate from the double ones by at most
+// 1e-4 on a grid of triangles and one of quads. n-gons with corners close to flat are ill conditioned and left out
+//
+// exits with 1 when a check fails
+
+#include "../IndicatorsTriangles.hh"
+#include "../IndicatorsPolygons.hh"
+#include "../IndicatorsStream.hh"
+#include "../IndicatorsInscribed.hh"
+#include "../IndicatorsDistribution.hh"
+#include "../IndicatorsWorst.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // distance of two doubles in units in the last place, 0 for two NaNs and unbounded for a NaN and a number
+    uint64_t ulp(const double _a, const double _b)
+    {
+        if (_a == _b || (std::isnan(_a) && std::isnan(_b)))
+            return 0;
+        if (std::isnan(_a) || std::isnan(_b))
+            return UINT64_MAX;
+
+        // the bits of the doubles in the order of their values
+        int64_t a, b;
+        std::memcpy(&a, &_a, sizeof(a));
+        std::memcpy(&b, &_b, sizeof(b));
+        if (a < 0)
+            a = INT64_MIN - a;
+        if (b < 0)
+            b = INT64_MIN - b;
+
+        return a > b ? uint64_t(a) - uint64_t(b) : uint64_t(b) - uint64_t(a);
+    }
+
+    bool check(const std::string& _name, const bool _passed, const std::string& _detail)
+    {
+        std::printf("%s %s: %s\n", _passed ? "passed" : "FAILED", _name.c_str(), _detail.c_str());
+        return _passed;
+    }
+
+    //================================================================================================================//
+    // coordinate arrays of triangles as taken by the kernels
+    class Batch
+    {
+    public:
+        void add(const double* _v0, const double* _v1, const double* _v2)
+        {
+            for (size_t k(0); k < 3; ++k)
+            {
+                c_[k].push_back(_v0[k]);
+                c_[3 + k].push_back(_v1[k]);
+                c_[6 + k].push_back(_v2[k]);
+            }
+            ++n_;
+        }
+
+        // padded with copies of the first triangle, no triangle can be added after it
+        indicatorsSimd::Triangles triangles()
+        {
+            const size_t padded = (n_ + indicatorsSimd::padding - 1) / indicatorsSimd::padding * indicatorsSimd::padding;
+
+            indicatorsSimd::Triangles t;
+            for (size_t k(0); k < 9; ++k)
+            {
+                c_[k].resize(padded, c_[k].front());
+                t.c[k] = c_[k].data();
+            }
+            t.n = padded;
+
+            return t;
+        }
+
+        // without the padding
+        size_t size() const { return n_; }
+
+    private:
+        std::vector<double> c_[9];
+        size_t n_ = 0;
+    };
+
+    // random triangles of coordinates in [1e-4, 1e4] in magnitude, a scale per triangle
+    Batch random_triangles(std::mt19937& _mt)
+    {
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::uniform_real_distribution<double> exponent(-4.0, 4.0);
+
+        Batch batch;
+        for (size_t i(0); i < 100000; ++i)
+        {
+            const double scale = std::pow(10.0, exponent(_mt));
+            double v[9];
+            for (size_t k(0); k < 9; ++k)
+            {
+                const double x = unit(_mt) * scale;
+                v[k] = std::copysign(std::max(std::abs(x), 1e-4), x);
+            }
+            batch.add(v, v + 3, v + 6);
+        }
+
+        return batch;
+    }
+
+    // coincident and collinear corners, and triangles whose 4 |v0v1 x v0v2|^2 is around FLT_MIN, where the
+    // circumradius of ACG::Geometry::circumRadius and of the kernels becomes FLT_MAX
+    Batch degenerated_triangles(std::mt19937& _mt)
+    {
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::uniform_real_distribution<double> factor(0.5, 2.0);
+
+        // height of a triangle of base 1 with 4 |cross|^2 = FLT_MIN
+        const double threshold = std::sqrt(double(FLT_MIN) / 4.0);
+
+        Batch batch;
+        for (size_t i(0); i < 30000; ++i)
+        {
+            double v[9];
+            for (size_t k(0); k < 9; ++k)
+            {
+                v[k] = unit(_mt);
+            }
+
+            switch (i % 5)
+            {
+                // all corners the same
+                case 0:     std::copy(v, v + 3, v + 3); std::copy(v, v + 3, v + 6); break;
+                // two corners the same
+                case 1:     std::copy(v + 3, v + 6, v + 6); break;
+                // on a line parallel to the x axis
+                case 2:     v[4] = v[7] = v[1]; v[5] = v[8] = v[2]; break;
+                // base 1 along the x axis and a height close to the threshold
+                default:
+                {
+                    const double h = threshold * factor(_mt) * (i % 5 == 3 ? 1.0 : std::ldexp(1.0, -2));
+                    const double w = unit(_mt);
+                    const double corners[9] = {0.0, 0.0, 0.0, 1.0, 0.0, 0.0, w, h, 0.0};
+                    std::copy(corners, corners + 9, v);
+                    break;
+                }
+            }
+            batch.add(v, v + 3, v + 6);
+        }
+
+        return batch;
+    }
+
+    // triangles so small that their squared edge lengths and products are subnormal or 0
+    Batch subnormal_triangles(std::mt19937& _mt)
+    {
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        std::uniform_real_distribution<double> exponent(-170.0, -150.0);
+
+        Batch batch;
+        for (size_t i(0); i < 30000; ++i)
+        {
+            const double scale = std::pow(10.0, exponent(_mt));
+            double v[9];
+            for (size_t k(0); k < 9; ++k)
+            {
+                v[k] = unit(_mt) * scale;
+            }
+            batch.add(v, v + 3, v + 6);
+        }
+
+        return batch;
+    }
+
+    // largest ulp distance of every indicator of the kernel of an instruction set to the scalar kernel
+    bool compare_kernel(const std::string& _name, Batch& _batch, const indicatorsSimd::isa& _isa)
+    {
+        const indicatorsSimd::Triangles t = _batch.triangles();
+        const size_t n = _batch.size();
+
+        std::vector<double> expected[4], values[4];
+        for (size_t k(0); k < 4; ++k)
+        {
+            expected[k].resize(t.n);
+            values[k].resize(t.n);
+        }
+
+        indicatorsSimd::triangles_scalar(t, {expected[0].data(), expected[1].data(), expected[2].data(), expected[3].data()});
+        indicatorsSimd::kernel(_isa)(t, {values[0].data(), values[1].data(), values[2].data(), values[3].data()});
+
+        static const char* names[4] = {"aspect ratio", "interpolation quality", "mean ratio", "shape regularity"};
+        static const uint64_t bounds[4] = {4, 16, 8, 4};
+
+        bool passed = true;
+        for (size_t k(0); k < 4; ++k)
+        {
+            uint64_t distance(0);
+            size_t worst(0);
+            for (size_t i(0); i < n; ++i)
+            {
+                const uint64_t d = ulp(expected[k][i], values[k][i]);
+                if (d > distance)
+                {
+                    distance = d;
+                    worst = i;
+                }
+            }
+
+            char detail[256];
+            std::snprintf(detail, sizeof(detail), "%s %llu ulp of %llu, %.17g for %.17g",
+                indicatorsSimd::as_s(_isa).c_str(), (unsigned long long)distance, (unsigned long long)bounds[k],
+                values[k][worst], expected[k][worst]);
+            passed = check("kernels " + _name + " " + names[k], distance <= bounds[k], detail) && passed;
+        }
+
+        return passed;
+    }
+
+    bool kernels()
+    {
+        std::mt19937 mt(1);
+        Batch random = random_triangles(mt);
+        Batch degenerated = degenerated_triangles(mt);
+        Batch subnormal = subnormal_triangles(mt);
+
+        bool passed = true;
+        for (int i(indicatorsSimd::SCALAR); i <= indicatorsSimd::detect(); ++i)
+        {
+            const indicatorsSimd::isa isa = indicatorsSimd::isa(i);
+            passed = compare_kernel("random", random, isa) && passed;
+            passed = compare_kernel("degenerated", degenerated, isa) && passed;
+            passed = compare_kernel("subnormal", subnormal, isa) && passed;
+        }
+
+        return passed;
+    }
+
+    //================================================================================================================//
+    using indicatorsRegistry::Point;
+
+    // angle at the corner _p between the directions to _a and _b
+    long double corner_angle(const Point& _a, const Point& _p, const Point& _b)
+    {
+        long double d0[3], d1[3];
+        for (size_t k(0); k < 3; ++k)
+        {
+            d0[k] = (long double)_a[k] - _p[k];
+            d1[k] = (long double)_b[k] - _p[k];
+        }
+
+        const long double x = d0[1] * d1[2] - d0[2] * d1[1];
+        const long double y = d0[2] * d1[0] - d0[0] * d1[2];
+        const long double z = d0[0] * d1[1] - d0[1] * d1[0];
+
+        return std::atan2(std::sqrt(x * x + y * y + z * z), d0[0] * d1[0] + d0[1] * d1[1] + d0[2] * d1[2]);
+    }
+
+    // sine of the smallest over sine of the largest corner angle
+    long double reference_skewness(const Point* _p, const size_t _n)
+    {
+        long double smallest = M_PI, largest = 0;
+        for (size_t i(0); i < _n; ++i)
+        {
+            const long double a = corner_angle(_p[(i + _n - 1) % _n], _p[i], _p[(i+1) % _n]);
+            smallest = std::min(smallest, a);
+            largest = std::max(largest, a);
+        }
+
+        return std::sin(smallest) / std::sin(largest);
+    }
+
+    // largest relative error of the skewness over faces made by _face from 20000 random triples of directions
+    template<class FaceT>
+    bool compare_skewness(const std::string& _name, const FaceT& _face, const double _bound, std::mt19937& _mt)
+    {
+        std::uniform_real_distribution<double> unit(-1.0, 1.0);
+        indicatorsRegistry::Skewness skewness;
+
+        double error(0.0);
+        for (size_t i(0); i < 20000; ++i)
+        {
+            const Point a(unit(_mt), unit(_mt), unit(_mt));
+            const Point d(unit(_mt), unit(_mt), unit(_mt));
+            const Point q(unit(_mt), unit(_mt), unit(_mt));
+
+            std::vector<Point> p = _face(a, d, q);
+            const long double expected = reference_skewness(p.data(), p.size());
+
+            double value;
+            if (p.size() == 3)
+            {
+                value = skewness(indicatorsRegistry::Triangle{p[0], p[1], p[2]});
+            }
+              else
+            {
+                indicatorsRegistry::Workspace workspace;
+                value = skewness(indicatorsRegistry::Polygon{p.data(), p.size(), &workspace});
+            }
+
+            error = std::max(error, double(std::abs((value - expected) / expected)));
+        }
+
+        char detail[128];
+        std::snprintf(detail, sizeof(detail), "relative error %.3g of %.3g", error, _bound);
+        return check("skewness " + _name, error <= _bound, detail);
+    }
+
+    bool skewness()
+    {
+        std::mt19937 mt(1);
+        bool passed = true;
+
+        passed = compare_skewness("random triangles", [](const Point& _a, const Point& _d, const Point& _q)
+            { return std::vector<Point>{_a, _d, _q}; }, 1e-14, mt) && passed;
+
+        // v2 close to the line v0 v1, beyond v1, the largest angle is close to pi
+        const auto sliver = [](const double _eps)
+        {
+            return [_eps](const Point& _a, const Point& _d, const Point& _q)
+                { return std::vector<Point>{_a, _a + _d, _a + _d * 2.0 + _q * _eps}; };
+        };
+        passed = compare_skewness("sliver triangles, eps 1e-5", sliver(1e-5), 4e-12, mt) && passed;
+        passed = compare_skewness("sliver triangles, eps 1e-9", sliver(1e-9), 4e-8, mt) && passed;
+
+        // v2 close to v1, the smallest angle is close to 0
+        passed = compare_skewness("needle triangles, eps 1e-9", [](const Point& _a, const Point& _d, const Point& _q)
+            { return std::vector<Point>{_a, _a + _d, _a + _d + _q * 1e-9}; }, 1e-8, mt) && passed;
+
+        // the second corner close to flat
+        passed = compare_skewness("quads with a flat corner, eps 1e-6", [](const Point& _a, const Point& _d, const Point& _q)
+            { return std::vector<Point>{_a, _a + _d, _a + _d * 2.0 + _q * 1e-6, _a + _q}; }, 4e-8, mt) && passed;
+
+        // no area, a flat angle gives 0
+        const Point o(0, 0, 0), x(1, 0, 0), x2(2, 0, 0);
+        const double collinear = indicatorsRegistry::Skewness()(indicatorsRegistry::Triangle{o, x, x2});
+        passed = check("skewness collinear triangle", collinear == 0.0, std::to_string(collinear)) && passed;
+
+        return passed;
+    }
+
+    //================================================================================================================//
+    // radius of the polygon _p in the xy plane, rotated about an axis out of the plane and moved
+    double inscribed_radius(IndicatorsInscribed& _inscribed, std::vector<Point> _p)
+    {
+        const Point axis = Point(1.0, 2.0, 3.0).normalize();
+        const double c = std::cos(0.7), s = std::sin(0.7);
+
+        for (auto& p: _p)
+        {
+            // Rodrigues' rotation
+            p = p * c + (axis % p) * s + axis * ((axis | p) * (1.0 - c)) + Point(10.0, -5.0, 3.0);
+        }
+
+        return _inscribed.radius(_p.data(), _p.size());
+    }
+
+    bool compare_inscribed(IndicatorsInscribed& _inscribed, const std::string& _name, const std::vector<Point>& _p,
+        const double _exact)
+    {
+        const double r = inscribed_radius(_inscribed, _p);
+        const double error = std::abs(r - _exact) / _exact;
+
+        char detail[128];
+        std::snprintf(detail, sizeof(detail), "%.17g for %.17g, relative error %.3g of 1e-9", r, _exact, error);
+        return check("inscribed " + _name, error <= 1e-9, detail);
+    }
+
+    bool inscribed()
+    {
+        IndicatorsInscribed solver;
+        bool passed = true;
+
+        // circumradius 1, inradius cos(pi / n)
+        for (size_t n(3); n <= 12; ++n)
+        {
+            std::vector<Point> p;
+            for (size_t k(0); k < n; ++k)
+            {
+                p.push_back(Point(std::cos(2.0 * M_PI * k / n), std::sin(2.0 * M_PI * k / n), 0.0));
+            }
+            passed = compare_inscribed(solver, "regular " + std::to_string(n) + "-gon", p, std::cos(M_PI / n)) && passed;
+        }
+
+        passed = compare_inscribed(solver, "rectangle 3 x 1",
+            {Point(0, 0, 0), Point(3, 0, 0), Point(3, 1, 0), Point(0, 1, 0)}, 0.5) && passed;
+        passed = compare_inscribed(solver, "rectangle 0.01 x 5",
+            {Point(0, 0, 0), Point(0.01, 0, 0), Point(0.01, 5, 0), Point(0, 5, 0)}, 0.005) && passed;
+
+        // touching both bases
+        passed = compare_inscribed(solver, "trapezoid 4 / 2 x 1",
+            {Point(0, 0, 0), Point(4, 0, 0), Point(3, 1, 0), Point(1, 1, 0)}, 0.5) && passed;
+
+        // touching the legs and the longer base, the incircle of the triangle of the legs up to (0, 20)
+        passed = compare_inscribed(solver, "trapezoid 2 / 1 x 10",
+            {Point(-1, 0, 0), Point(1, 0, 0), Point(0.5, 10, 0), Point(-0.5, 10, 0)}, 20.0 / (1.0 + std::sqrt(401.0)))
+            && passed;
+
+        // corners on the edges of a square and of a rectangle
+        passed = compare_inscribed(solver, "square with collinear corners",
+            {Point(0, 0, 0), Point(1, 0, 0), Point(2, 0, 0), Point(2, 1, 0), Point(2, 2, 0), Point(0, 2, 0)}, 1.0)
+            && passed;
+        passed = compare_inscribed(solver, "rectangle with collinear corners",
+            {Point(0, 0, 0), Point(1, 0, 0), Point(2.5, 0, 0), Point(4, 0, 0), Point(4, 1, 0), Point(2, 1, 0),
+             Point(0, 1, 0), Point(0, 0.5, 0)}, 0.5) && passed;
+
+        // not convex, the largest incircle of the ears is a lower bound of the exact 0.5
+        const double l = inscribed_radius(solver,
+            {Point(0, 0, 0), Point(2, 0, 0), Point(2, 1, 0), Point(1, 1, 0), Point(1, 2, 0), Point(0, 2, 0)});
+        passed = check("inscribed L-shape", l > 0.4 && l <= 0.5, std::to_string(l) + " in (0.4, 0.5]") && passed;
+
+        const double lc = inscribed_radius(solver, {Point(0, 0, 0), Point(1, 0, 0), Point(2, 0, 0), Point(2, 1, 0),
+            Point(1, 1, 0), Point(1, 2, 0), Point(0, 2, 0), Point(0, 1, 0)});
+        passed = check("inscribed L-shape with collinear corners", lc > 0.25 && lc <= 0.5,
+            std::to_string(lc) + " in (0.25, 0.5]") && passed;
+
+        return passed;
+    }
+
+    bool same(const double _a, const double _b)
+    {
+        return std::memcmp(&_a, &_b, sizeof(double)) == 0;
+    }
+
+    // same counts, bins and quantiles
+    bool same(const IndicatorsDistribution& _a, const IndicatorsDistribution& _b)
+    {
+        if (_a.size() != _b.size() || _a.n_bins() != _b.n_bins() || _a.below() != _b.below() || _a.above() != _b.above())
+            return false;
+
+        for (size_t i(0); i < _a.n_bins(); ++i)
+        {
+            if (_a.bin(i) != _b.bin(i))
+                return false;
+        }
+
+        for (size_t q(0); q <= 100; ++q)
+        {
+            if (!same(_a.quantile(q / 100.0), _b.quantile(q / 100.0)))
+                return false;
+        }
+
+        return true;
+    }
+
+    // values spread over 7 orders of magnitude, every 100th is 0 and every 1000th NaN
+    std::vector<double> distribution_values(std::mt19937& _mt, const size_t _n)
+    {
+        std::uniform_real_distribution<double> exponent(-6.0, 1.0);
+
+        std::vector<double> values;
+        for (size_t i(0); i < _n; ++i)
+        {
+            const double value = std::pow(10.0, exponent(_mt));
+            values.push_back(i % 1000 == 999 ? std::numeric_limits<double>::quiet_NaN() : i % 100 == 99 ? 0.0 : value);
+        }
+
+        return values;
+    }
+
+    bool distribution()
+    {
+        std::mt19937 mt(3);
+        const std::vector<double> first = distribution_values(mt, 20000), second = distribution_values(mt, 30000);
+
+        IndicatorsDistribution a(10, 0.0, 1.0), b(10, 0.0, 1.0), all(10, 0.0, 1.0);
+        std::vector<double> sorted;
+        for (auto v: first)
+        {
+            a.add(v);
+            all.add(v);
+            if (!std::isnan(v))
+                sorted.push_back(v);
+        }
+        for (auto v: second)
+        {
+            b.add(v);
+            all.add(v);
+            if (!std::isnan(v))
+                sorted.push_back(v);
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        bool passed = check("distribution size", all.size() == sorted.size(),
+            std::to_string(all.size()) + " of " + std::to_string(sorted.size()));
+
+        // nearest rank, the middle of a bucket of 1/128 of a power of two
+        double error(0.0);
+        for (size_t q(0); q <= 100; ++q)
+        {
+            const double expected = sorted[size_t(q / 100.0 * (sorted.size() - 1))];
+            const double value = all.quantile(q / 100.0);
+            error = std::max(error, expected > 0 ? std::abs(value - expected) / expected : std::abs(value));
+        }
+
+        char detail[128];
+        std::snprintf(detail, sizeof(detail), "relative error %.3g of %.3g", error, 1.0 / 256);
+        passed = check("distribution quantiles", error <= 1.0 / 256, detail) && passed;
+
+        // bins and their bounds
+        bool counted = all.below() == 0 && all.above() == size_t(std::count_if(sorted.begin(), sorted.end(),
+            [](const double _v) { return _v > 1.0; }));
+        for (size_t i(0); i <= all.n_bins(); ++i)
+        {
+            const double bound = i < all.n_bins() ? all.bin_lo(i) : all.bin_hi(i - 1);
+            const size_t below = size_t(std::lower_bound(sorted.begin(), sorted.end(), bound) - sorted.begin());
+            counted = counted && all.count_below(bound) == below;
+        }
+        passed = check("distribution histogram", counted, "count_below() on the bounds of 10 bins") && passed;
+
+        IndicatorsDistribution merged = a;
+        merged.merge(b);
+        passed = check("distribution merge", same(merged, all), "first and second values") && passed;
+
+        merged = b;
+        merged.merge(a);
+        passed = check("distribution merge reversed", same(merged, all), "second and first values") && passed;
+
+        IndicatorsDistribution subtracted = all;
+        subtracted.subtract(b);
+        passed = check("distribution subtract", same(subtracted, a), "all but the second values") && passed;
+
+        IndicatorsDistribution removed = all;
+        for (auto v: first)
+        {
+            removed.remove(v);
+        }
+        passed = check("distribution remove", same(removed, b), "all but the first values, one by one") && passed;
+
+        return passed;
+    }
+
+    // same faces and values, in the same order
+    bool same(const IndicatorsWorst& _w, const std::vector<IndicatorsWorst::Face>& _faces)
+    {
+        const std::vector<IndicatorsWorst::Face> faces = _w.faces();
+        if (faces.size() != _faces.size())
+            return false;
+
+        for (size_t i(0); i < faces.size(); ++i)
+        {
+            if (faces[i].face != _faces[i].face || !same(faces[i].value, _faces[i].value))
+                return false;
+        }
+
+        return true;
+    }
+
+    bool same(const IndicatorsWorst& _a, const IndicatorsWorst& _b)
+    {
+        return same(_a, _b.faces());
+    }
+
+    // the _k worst of _values below or above _threshold, NaN first and the ties by face index
+    std::vector<IndicatorsWorst::Face> reference_worst(const std::vector<double>& _values, const size_t _k,
+        const double _threshold, const bool _higher_is_worse)
+    {
+        auto key = [&](const double _value)
+        {
+            return std::isnan(_value) ? -std::numeric_limits<double>::infinity() : _higher_is_worse ? -_value : _value;
+        };
+
+        std::vector<IndicatorsWorst::Face> faces;
+        for (size_t f(0); f < _values.size(); ++f)
+        {
+            if (std::isnan(_threshold) || key(_values[f]) < key(_threshold))
+                faces.push_back({static_cast<unsigned int>(f), _values[f]});
+        }
+
+        std::sort(faces.begin(), faces.end(), [&](const IndicatorsWorst::Face& _a, const IndicatorsWorst::Face& _b)
+        {
+            return key(_a.value) < key(_b.value) || (key(_a.value) == key(_b.value) && _a.face < _b.face);
+        });
+        faces.resize(std::min(faces.size(), _k));
+
+        return faces;
+    }
+
+    // chunks of 1000 faces limited by the running selection and merged into it, as the face loops do
+    IndicatorsWorst chunked_worst(const std::vector<double>& _values, const size_t _k, const double _threshold,
+        const bool _higher_is_worse)
+    {
+        IndicatorsWorst worst(_k, _threshold, _higher_is_worse);
+        for (size_t begin(0); begin < _values.size(); begin += 1000)
+        {
+            IndicatorsWorst chunk(_k, _threshold, _higher_is_worse);
+            chunk.limit(worst);
+            for (size_t f(begin); f < std::min(_values.size(), begin + 1000); ++f)
+            {
+                chunk.add(static_cast<unsigned int>(f), _values[f]);
+            }
+            worst.merge(chunk);
+        }
+        return worst;
+    }
+
+    bool worst()
+    {
+        std::mt19937 mt(5);
+        std::uniform_int_distribution<int> hundredths(0, 100);
+
+        // many ties, and a few NaN
+        std::vector<double> values(20000);
+        for (size_t f(0); f < values.size(); ++f)
+        {
+            values[f] = f % 997 == 0 ? std::numeric_limits<double>::quiet_NaN() : hundredths(mt) / 100.0;
+        }
+
+        bool passed = true;
+        for (const bool higher_is_worse: {false, true})
+        {
+            for (const double threshold: {std::numeric_limits<double>::quiet_NaN(), 0.5})
+            {
+                const std::string query = std::string(higher_is_worse ? "highest" : "lowest")
+                    + (std::isnan(threshold) ? "" : " beyond 0.5");
+                const std::vector<IndicatorsWorst::Face> expected = reference_worst(values, 100, threshold, higher_is_worse);
+
+                passed = check("worst " + query + " in chunks",
+                    same(chunked_worst(values, 100, threshold, higher_is_worse), expected), "100 faces") && passed;
+
+                std::vector<unsigned int> order(values.size());
+                for (size_t f(0); f < order.size(); ++f)
+                {
+                    order[f] = static_cast<unsigned int>(f);
+                }
+                std::shuffle(order.begin(), order.end(), mt);
+
+                IndicatorsWorst shuffled(100, threshold, higher_is_worse);
+                for (auto f: order)
+                {
+                    shuffled.add(f, values[f]);
+                }
+                passed = check("worst " + query + " shuffled", same(shuffled, expected), "100 faces") && passed;
+            }
+        }
+
+        // faces that were not kept leave the selection complete
+        IndicatorsWorst full = chunked_worst(values, 100, std::numeric_limits<double>::quiet_NaN(), false);
+        const std::vector<IndicatorsWorst::Face> kept = full.faces();
+        std::vector<unsigned int> others;
+        for (unsigned int f(0); others.size() < 10; ++f)
+        {
+            if (std::none_of(kept.begin(), kept.end(), [f](const IndicatorsWorst::Face& _face) { return _face.face == f; }))
+                others.push_back(f);
+        }
+        full.remove(others);
+        passed = check("worst remove not kept", full.complete() && same(full, kept), "10 faces") && passed;
+
+        // a kept face, the one that would replace it was left out
+        full.remove({kept.back().face});
+        passed = check("worst remove kept", !full.complete(), "incomplete") && passed;
+
+        // with no face left out the selection is updated in place
+        const double threshold = 0.02;
+        IndicatorsWorst all = chunked_worst(values, 1000, threshold, false);
+        std::vector<unsigned int> moved;
+        for (unsigned int f(0); f < values.size(); f += 50)
+        {
+            moved.push_back(f);
+        }
+        all.remove(moved);
+        for (auto f: moved)
+        {
+            values[f] = hundredths(mt) / 100.0;
+            all.add(f, values[f]);
+        }
+        passed = check("worst remove and add", all.complete() && same(all, reference_worst(values, 1000, threshold, false)),
+            std::to_string(all.size()) + " faces below " + std::to_string(threshold)) && passed;
+
+        return passed;
+    }
+
+    //================================================================================================================//
+    // (n+1)^2 vertices of a grid moved by up to a third of a cell, split in triangles or as quads, and above it
+    // _ngons n-gons of 5 to 8 corners
+    template<class MeshT>
+    void grid(MeshT& _mesh, const size_t _n, const bool _triangles, const size_t _ngons = 0)
+    {
+        std::mt19937 mt(1);
+        std::uniform_real_distribution<double> offset(-0.3, 0.3);
+
+        std::vector<typename MeshT::VertexHandle> v;
+        for (size_t j(0); j <= _n; ++j)
+        {
+            for (size_t i(0); i <= _n; ++i)
+            {
+                v.push_back(_mesh.add_vertex(typename MeshT::Point(i + offset(mt), j + offset(mt), offset(mt))));
+            }
+        }
+
+        for (size_t j(0); j < _n; ++j)
+        {
+            for (size_t i(0); i < _n; ++i)
+            {
+                const size_t a = j * (_n + 1) + i;
+                if (_triangles)
+                {
+                    _mesh.add_face(v[a], v[a + 1], v[a + _n + 2]);
+                    _mesh.add_face(v[a], v[a + _n + 2], v[a + _n + 1]);
+                }
+                  else
+                {
+                    _mesh.add_face(std::vector<typename MeshT::VertexHandle>{v[a], v[a + 1], v[a + _n + 2], v[a + _n + 1]});
+                }
+            }
+        }
+
+        for (size_t i(0); i < _ngons; ++i)
+        {
+            const size_t n = 5 + i % 4;
+            std::vector<typename MeshT::VertexHandle> face;
+            for (size_t k(0); k < n; ++k)
+            {
+                const double a = 2.0 * M_PI * k / n;
+                face.push_back(_mesh.add_vertex(typename MeshT::Point(i + std::cos(a) * (1.0 + offset(mt)),
+                    _n + 2.0 + std::sin(a) * (1.0 + offset(mt)), offset(mt))));
+            }
+            _mesh.add_face(face);
+        }
+    }
+
+    // false at the first indicator whose results, distributions, worst faces or face values differ
+    bool same(const std::vector<Indicators::Result>& _a, const std::vector<Indicators::Result>& _b,
+        const Indicators& _ia, const Indicators& _ib, const size_t _n_faces, std::string& _detail)
+    {
+        const std::vector<indicatorsType::indicators> all = indicatorsType::all();
+
+        for (size_t k(0); k < all.size(); ++k)
+        {
+            _detail = indicatorsType::as_s(all[k]);
+            if (!same(_a[k].min, _b[k].min) || !same(_a[k].max, _b[k].max) || !same(_a[k].average, _b[k].average)
+                || _a[k].nb != _b[k].nb)
+                return false;
+
+            if (!same(_a[k].distribution, _b[k].distribution))
+            {
+                _detail += " distribution";
+                return false;
+            }
+
+            if (!same(_a[k].worst, _b[k].worst))
+            {
+                _detail += " worst faces";
+                return false;
+            }
+
+            // undefined on the faces of the mesh
+            if (_a[k].min < 0)
+                continue;
+
+            for (size_t f(0); f < _n_faces; ++f)
+            {
+                if (!same(_ia.value(all[k], f), _ib.value(all[k], f)))
+                {
+                    _detail += " of face " + std::to_string(f);
+                    return false;
+                }
+            }
+        }
+
+        _detail = "same results, distributions, worst faces and face values";
+        return true;
+    }
+
+    template<class IndicatorsT, class MeshT>
+    bool compare_stream(const std::string& _name, MeshT& _mesh)
+    {
+        const std::string mesh_file = "IndicatorsTest.imesh";
+        const std::string values_file = "IndicatorsTest.values";
+        const std::vector<indicatorsType::indicators> all = indicatorsType::all();
+        const size_t n_faces = _mesh.n_faces();
+
+        IndicatorsT memory(_mesh);
+        memory.set_coloring(false);
+        const std::vector<Indicators::Result> expected = memory.compute_all(all);
+
+        bool passed = check("stream " + _name + " write", IndicatorsStream::write(_mesh, mesh_file), mesh_file);
+
+        // blocks of 2 chunks
+        IndicatorsStream stream;
+        passed = check("stream " + _name + " open", stream.open(mesh_file, values_file), mesh_file) && passed;
+        stream.set_stream_faces(8192);
+        const std::vector<Indicators::Result> streamed = stream.compute_all(all);
+
+        const size_t faces = stream.profile().report().counters[IndicatorsProfile::FACES];
+        passed = check("stream " + _name + " evaluation", !stream.failed() && faces == n_faces,
+            std::to_string(faces) + " faces of " + std::to_string(n_faces)) && passed;
+
+        std::string detail;
+        passed = check("stream " + _name + " values", same(expected, streamed, memory, stream, n_faces, detail), detail)
+            && passed;
+
+        // the values file makes every indicator up to date, the evaluation only returns the results
+        IndicatorsT loaded(_mesh);
+        loaded.set_coloring(false);
+        passed = check("stream " + _name + " load_values", loaded.load_values(values_file), values_file) && passed;
+        const std::vector<Indicators::Result> reloaded = loaded.compute_all(all);
+
+        const size_t evaluated = loaded.profile().report().counters[IndicatorsProfile::FACES];
+        passed = check("stream " + _name + " loaded values",
+            same(expected, reloaded, memory, loaded, n_faces, detail) && evaluated == 0,
+            detail + ", " + std::to_string(evaluated) + " faces evaluated") && passed;
+
+        std::remove(mesh_file.c_str());
+        std::remove(values_file.c_str());
+
+        return passed;
+    }
+
+    bool stream()
+    {
+        TriMesh triangles;
+        grid(triangles, 100, true);
+
+        PolyMesh polygons;
+        grid(polygons, 80, false, 800);
+
+        bool passed = compare_stream<IndicatorsTriangles>("triangles", triangles);
+        passed = compare_stream<IndicatorsPolygons>("polygons", polygons) && passed;
+
+        return passed;
+    }
+
+    //================================================================================================================//
+    // largest deviation of a face value and of the results of every indicator from the double precision ones
+    template<class IndicatorsT, class MeshT>
+    bool compare_precision(const std::string& _name, MeshT& _mesh, const double _bound)
+    {
+        const std::vector<indicatorsType::indicators> all = indicatorsType::all();
+
+        IndicatorsT exact(_mesh);
+        exact.set_coloring(false);
+        const std::vector<Indicators::Result> expected = exact.compute_all(all);
+
+        // the values of exact are read before single moves the properties to float
+        std::vector<std::vector<double>> reference(all.size());
+        for (size_t k(0); k < all.size(); ++k)
+        {
+            for (size_t f(0); expected[k].min >= 0 && f < _mesh.n_faces(); ++f)
+            {
+                reference[k].push_back(exact.value(all[k], f));
+            }
+        }
+
+        IndicatorsT single(_mesh);
+        single.set_coloring(false);
+        single.set_single_precision(true);
+        const std::vector<Indicators::Result> results = single.compute_all(all);
+
+        bool passed = true;
+        for (size_t k(0); k < all.size(); ++k)
+        {
+            if (expected[k].min < 0)
+                continue;
+
+            double deviation = std::max(std::abs(results[k].min - expected[k].min), std::abs(results[k].max - expected[k].max));
+            deviation = std::max(deviation, std::abs(results[k].average - expected[k].average));
+            for (size_t f(0); f < reference[k].size(); ++f)
+            {
+                const double value = single.value(all[k], f);
+                if (std::isnan(value) != std::isnan(reference[k][f]))
+                    deviation = std::numeric_limits<double>::infinity();
+                  else if (!std::isnan(value))
+                    deviation = std::max(deviation, std::abs(value - reference[k][f]));
+            }
+
+            char detail[128];
+            std::snprintf(detail, sizeof(detail), "deviation %.3g of %.3g", deviation, _bound);
+            passed = check("precision " + _name + " " + indicatorsType::as_s(all[k]), deviation <= _bound, detail)
+                && passed;
+        }
+
+        return passed;
+    }
+
+    bool precision()
+    {
+        TriMesh triangles;
+        grid(triangles, 100, true);
+
+        PolyMesh quads;
+        grid(quads, 80, false);
+
+        bool passed = compare_precision<IndicatorsTriangles>("triangles", triangles, 1e-4);
+        passed = compare_precision<IndicatorsPolygons>("quads", quads, 1e-4) && passed;
+
+        return passed;
+    }
+
+    //================================================================================================================//
+    void configure(Indicators& _indicators)
+    {
+        _indicators.set_coloring(false);
+        _indicators.set_histogram(20, 0.0, 1.0);
+        _indicators.set_worst_faces(50);
+    }
+
+    // rounds of 50 moved vertices, and a corner of the worst face of every indicator so that the selections lose
+    // a kept face and are collected again
+    template<class IndicatorsT, class MeshT>
+    bool compare_incremental(const std::string& _name, MeshT& _mesh)
+    {
+        const std::vector<indicatorsType::indicators> all = indicatorsType::all();
+        const size_t n_faces = _mesh.n_faces();
+
+        IndicatorsT incremental(_mesh);
+        configure(incremental);
+        std::vector<Indicators::Result> results = incremental.compute_all(all);
+
+        std::mt19937 mt(7);
+        std::uniform_real_distribution<double> offset(-0.2, 0.2);
+
+        bool passed = true;
+        for (size_t round(0); round < 3; ++round)
+        {
+            std::vector<typename MeshT::VertexHandle> vertices;
+            for (size_t i(0); i < 50; ++i)
+            {
+                vertices.push_back(typename MeshT::VertexHandle(int(mt() % _mesh.n_vertices())));
+            }
+            for (const auto& result: results)
+            {
+                if (result.worst.size())
+                    vertices.push_back(*_mesh.fv_range(_mesh.face_handle(result.worst.faces().front().face)).begin());
+            }
+
+            std::vector<unsigned int> moved;
+            for (const auto& vh: vertices)
+            {
+                _mesh.set_point(vh, _mesh.point(vh) + typename MeshT::Point(offset(mt), offset(mt), offset(mt)));
+                moved.push_back(vh.idx());
+            }
+            incremental.vertices_changed(moved);
+
+            results = incremental.compute_all(all);
+            const size_t evaluated = incremental.profile().report().counters[IndicatorsProfile::FACES];
+
+            IndicatorsT full(_mesh);
+            configure(full);
+            const std::vector<Indicators::Result> expected = full.compute_all(all);
+
+            std::string detail;
+            const bool equal = same(expected, results, full, incremental, n_faces, detail);
+            passed = check("incremental " + _name + " round " + std::to_string(round), equal && evaluated < n_faces,
+                detail + ", " + std::to_string(evaluated) + " of " + std::to_string(n_faces) + " faces evaluated")
+                && passed;
+        }
+
+        return passed;
+    }
+
+    bool incremental()
+    {
+        TriMesh triangles;
+        grid(triangles, 100, true);
+
+        PolyMesh polygons;
+        grid(polygons, 80, false, 800);
+
+        bool passed = compare_incremental<IndicatorsTriangles>("triangles", triangles);
+        passed = compare_incremental<IndicatorsPolygons>("polygons", polygons) && passed;
+
+        return passed;
+    }
+}
+
+//====================================================================================================================//
+int main()
+{
+    bool passed = kernels();
+    passed = skewness() && passed;
+    passed = inscribed() && passed;
+    passed = distribution() && passed;
+    passed = worst() && passed;
+    passed = stream() && passed;
+    passed = incremental() && passed;
+    passed = precision() && passed;
+
+    return passed ? 0 : 1;
+}